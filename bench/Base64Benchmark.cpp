@@ -0,0 +1,151 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Throughput of Base64 on thumbnail sized inputs (2-50 KB), for every
+// implementation the CPU supports, compared with the OpenSSL BIO chain used
+// before. Every implementation is first checked against OpenSSL on all
+// sizes from 0 to 300 bytes and on the benchmark inputs.
+//
+// Usage: base64_benchmark
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <openssl/bio.h>
+#include <openssl/buffer.h>
+#include <openssl/evp.h>
+
+#include "Base64.h"
+#include "BenchmarkUtils.h"
+#include "HtmlBuffer.h"
+
+// The encoder used before Base64
+static std::string encodeOpenSsl(const std::vector<unsigned char>& data)
+{
+    BIO* b64 = BIO_new(BIO_f_base64());
+    BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL);
+    BIO* bio = BIO_push(b64, BIO_new(BIO_s_mem()));
+
+    BIO_write(bio, data.data(), (int)data.size());
+    BIO_flush(bio);
+
+    BUF_MEM* bufferPtr = nullptr;
+    BIO_get_mem_ptr(bio, &bufferPtr);
+    std::string output(bufferPtr->data, bufferPtr->length);
+
+    BIO_free_all(bio);
+    return output;
+}
+
+static std::vector<unsigned char> createRandomBytes(std::mt19937& random, size_t size)
+{
+    std::vector<unsigned char> bytes(size);
+    for (auto& b : bytes)
+        b = static_cast<unsigned char>(random());
+    return bytes;
+}
+
+int main()
+{
+    std::mt19937 random(42);
+
+    const std::pair<Base64::Implementation, const char*> implementations[] = {
+        {Base64::Implementation::SCALAR, "scalar"},
+        {Base64::Implementation::SSSE3, "SSSE3"},
+        {Base64::Implementation::AVX2, "AVX2"},
+    };
+
+    bool allCorrect = true;
+    for (size_t size = 0; size <= 300; ++size)
+    {
+        std::vector<unsigned char> data = createRandomBytes(random, size);
+        std::string expected = encodeOpenSsl(data);
+        for (auto [implementation, name] : implementations)
+        {
+            if (!Base64::isSupported(implementation))
+                continue;
+            HtmlBuffer out;
+            Base64::append(out, data, implementation);
+            if (!out.equals(expected))
+            {
+                std::cout << name << " differs from OpenSSL for " << size << " bytes\n";
+                allCorrect = false;
+            }
+        }
+    }
+
+    const size_t sizes[] = {2 * 1024, 8 * 1024, 20 * 1024, 50 * 1024};
+    for (size_t size : sizes)
+    {
+        // As many thumbnails as a channel page with 5000 videos inlines
+        const int count = 5000;
+        std::vector<std::vector<unsigned char>> inputs;
+        std::string expected;
+        for (int i = 0; i < count; ++i)
+        {
+            inputs.push_back(createRandomBytes(random, size + i % 3));
+            expected += encodeOpenSsl(inputs.back());
+        }
+        double megaBytes = 0;
+        for (const auto& input : inputs)
+            megaBytes += input.size() / 1024.0 / 1024.0;
+
+        std::cout << count << " inputs of " << size / 1024 << " KB\n";
+        auto report = [&](const char* name, double ms, bool ok) {
+            std::cout << "  " << std::left << std::setw(8) << name << std::right << std::fixed
+                      << std::setprecision(1) << std::setw(8) << ms << " ms "
+                      << std::setw(8) << megaBytes / (ms / 1000.0) << " MB/s"
+                      << (ok ? "" : "  WRONG OUTPUT") << "\n";
+        };
+
+        {
+            HtmlBuffer out;
+            double ms = measureMilliseconds([&] {
+                for (const auto& input : inputs)
+                    out << encodeOpenSsl(input);
+            });
+            report("OpenSSL", ms, out.equals(expected));
+        }
+
+        for (auto [implementation, name] : implementations)
+        {
+            if (!Base64::isSupported(implementation))
+            {
+                std::cout << "  " << std::left << std::setw(8) << name << "not supported\n";
+                continue;
+            }
+
+            HtmlBuffer out;
+            double ms = measureMilliseconds([&] {
+                for (const auto& input : inputs)
+                    Base64::append(out, input, implementation);
+            });
+            bool ok = out.equals(expected);
+            allCorrect = allCorrect && ok;
+            report(name, ms, ok);
+        }
+    }
+    return allCorrect ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "YoutubeVideo.h"
+
+struct BenchmarkResult {
+    double milliseconds = 0;
+    long peakRssKiloBytes = 0;
+    bool succeeded = false;
+};
+
+// Runs the function in a forked child process, so the peak RSS of every
+// measurement is independent of the previous ones.
+// The function returns false when the measured code produced a wrong result.
+inline BenchmarkResult runIsolated(const std::function<bool()>& f)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        std::perror("pipe");
+        std::exit(1);
+    }
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        close(fds[0]);
+        auto start = std::chrono::steady_clock::now();
+        bool ok = f();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (write(fds[1], &ms, sizeof(ms)) != sizeof(ms))
+            _exit(1);
+        _exit(ok ? 0 : 1);
+    }
+
+    close(fds[1]);
+    BenchmarkResult result;
+    if (read(fds[0], &result.milliseconds, sizeof(result.milliseconds)) != sizeof(result.milliseconds))
+        result.milliseconds = -1;
+    close(fds[0]);
+
+    int status = 0;
+    struct rusage usage {};
+    wait4(pid, &status, 0, &usage);
+    result.peakRssKiloBytes = usage.ru_maxrss;
+    result.succeeded = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    return result;
+}
+
+template<class F>
+double measureMilliseconds(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ------------------- synthetic archive -----------------------
+
+// Every fifth video has no description
+inline std::string createSyntheticDescription(size_t i)
+{
+    return i % 5 == 4 ? "" : "First line of the description\nSecond line\n\nhttps://example.com/?a=b";
+}
+
+// Videos spread over channelCount channels, the videos of a channel are next
+// to each other and numbered like ChannelIndex does. Every third video is an
+// MKV file, so the pages take all of their branches. A quarter of the
+// comments are top level comments, the others reply to the last of them.
+inline std::vector<YoutubeVideo> createSyntheticVideos(size_t videoCount, size_t commentsPerVideo,
+                                                       size_t channelCount = 20)
+{
+    std::vector<YoutubeVideo> videos;
+    videos.reserve(videoCount);
+    size_t previousChannel = SIZE_MAX;
+    int number = 0;
+    for (size_t i = 0; i < videoCount; ++i)
+    {
+        YoutubeVideo v;
+        v.id = "video" + std::to_string(i);
+        v.snapshot = "1700000000." + std::to_string(i);
+        v.title = "Synthetic video number " + std::to_string(i);
+        bool mkv = i % 3 == 2;
+        v.videoFileName = mkv ? "Synthetic video (" + std::to_string(i) + ").mkv" : v.id + ".mp4";
+        v.ext = mkv ? "mkv" : "mp4";
+        v.videoFileSizeInBytes = 100000000L + static_cast<long>(i) * 7919;
+        v.videoFileSha512HashSum = std::string(128, 'a');
+        v.videoDuration = "00:12:34.56";
+
+        size_t channel = i * channelCount / videoCount;
+        v.channelName = "Channel " + std::to_string(channel);
+        v.channelUrl = "https://www.youtube.com/channel/UC" + std::to_string(channel);
+        v.channelId = "UC" + std::to_string(channel);
+        number = channel == previousChannel ? number + 1 : 1;
+        previousChannel = channel;
+        v.number = number;
+        if (i > 0)
+            v.previousVideoId = "video" + std::to_string(i - 1);
+        if (i + 1 < videoCount)
+            v.nextVideoId = "video" + std::to_string(i + 1);
+
+        v.uploadDate = "20240101";
+        v.timestamp = 1704067200L + static_cast<long>(i);
+        v.description = createSyntheticDescription(i);
+        v.thumbnail = "https://i.ytimg.com/vi/" + v.id + "/maxresdefault.webp";
+        v.miniThumbnail = "https://i.ytimg.com/vi/" + v.id + "/mqdefault.jpg";
+
+        YoutubeComments::Builder comments;
+        std::string parent;
+        for (size_t c = 0; c < commentsPerVideo; ++c)
+        {
+            std::string text = "Comment number " + std::to_string(c) + ", with a text of a typical length for YouTube.";
+            std::string author = "@user" + std::to_string(c % 5000);
+            long timestamp = 1700000000L + static_cast<long>(c);
+            if (c % 4 == 0)
+            {
+                parent = "Ugx" + std::to_string(c);
+                comments.add(parent, "root", text, author, timestamp);
+            }
+            else
+            {
+                comments.add(parent + ".r" + std::to_string(c), parent, text, author, timestamp);
+            }
+        }
+        v.comments = comments.build().getThreaded();
+        videos.push_back(std::move(v));
+    }
+    return videos;
+}
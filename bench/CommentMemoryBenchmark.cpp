@@ -0,0 +1,122 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Heap bytes per comment and peak RSS of an archive's comments, stored as
+// a vector of YoutubeComment per video as before, against one
+// YoutubeComments arena per video. The synthetic comments look like
+// YouTube ones: 26 character ids, a quarter are replies, authors repeat
+// and texts have varying lengths.
+//
+// Usage: comment_memory_benchmark [number of comments] [comments per video]
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "BenchmarkUtils.h"
+#include "YoutubeComment.h"
+#include "YoutubeComments.h"
+
+static std::string makeId(size_t i, size_t length)
+{
+    static const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    std::string id = "Ugx";
+    uint64_t x = i * 0x9E3779B97F4A7C15ULL + 1;
+    while (id.size() < length)
+    {
+        x ^= x >> 29;
+        x *= 0xBF58476D1CE4E5B9ULL;
+        id += alphabet[x % 64];
+    }
+    return id;
+}
+
+// The i-th synthetic comment, written into the given one to reuse its strings
+static void makeComment(size_t i, size_t count, YoutubeComment& comment)
+{
+    if (i % 4 == 3)
+    {
+        comment.parentId = makeId(i - 1 - (i % 16) / 4, 26);
+        comment.id = comment.parentId + "." + makeId(i, 22);
+    }
+    else
+    {
+        comment.parentId = "root";
+        comment.id = makeId(i, 26);
+    }
+    comment.author = "@user" + std::to_string((i * 7919) % (count / 10 + 1));
+    comment.text.assign(40 + (i * 31) % 260, 'x');
+    comment.timestamp = 1700000000L + static_cast<long>(i);
+}
+
+static void report(const std::string& name, size_t count, const std::function<long()>& build)
+{
+    std::cout << std::flush;
+    BenchmarkResult result = runIsolated([&] {
+        long before = AllocationCounter::getLiveBytes();
+        long bytes = build() - before;
+        std::cout << std::left << std::setw(26) << name
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(8)
+                  << static_cast<double>(bytes) / static_cast<double>(count) << " heap bytes per comment" << std::flush;
+        return true;
+    });
+    std::cout << std::fixed << std::setw(10) << result.peakRssKiloBytes / 1024 << " MB peak RSS "
+              << std::setprecision(0) << std::setw(8) << result.milliseconds << " ms\n";
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    size_t perVideo = argc > 2 ? std::stoul(argv[2]) : 1000;
+
+    report("vector<YoutubeComment>", count, [count, perVideo] {
+        std::vector<std::vector<YoutubeComment>> videos;
+        YoutubeComment comment;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i % perVideo == 0)
+                videos.emplace_back();
+            makeComment(i, count, comment);
+            videos.back().push_back(comment);
+        }
+        return AllocationCounter::getLiveBytes();
+    });
+
+    report("YoutubeComments, threaded", count, [count, perVideo] {
+        std::vector<YoutubeComments> videos;
+        YoutubeComments::Builder builder;
+        YoutubeComment comment;
+        for (size_t i = 0; i < count; ++i)
+        {
+            makeComment(i, count, comment);
+            builder.add(comment);
+            if (builder.size() == perVideo || i + 1 == count)
+                videos.push_back(builder.build().getThreaded());
+        }
+        return AllocationCounter::getLiveBytes();
+    });
+
+    return 0;
+}
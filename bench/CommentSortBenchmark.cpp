@@ -0,0 +1,157 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Time and heap allocations of YoutubeComments::getThreaded on synthetic comment
+// trees: top-level comments with replies, and one long reply chain.
+// The previous recursive implementation is quadratic, it is measured
+// only on the small tree.
+//
+// Usage: comment_sort_benchmark
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "BenchmarkUtils.h"
+#include "YoutubeComment.h"
+#include "YoutubeComments.h"
+
+// The implementation before the threaded order
+static std::vector<YoutubeComment> legacyGetChildren(const std::vector<YoutubeComment>& all, const std::string& parentId)
+{
+    std::vector<YoutubeComment> children;
+    for (auto& c : all)
+    {
+        if (c.parentId == parentId)
+            children.push_back(c);
+    }
+    std::sort(children.begin(), children.end());
+
+    std::vector<YoutubeComment> result;
+    for (auto& c : children)
+    {
+        result.push_back(c);
+        auto sub = legacyGetChildren(all, c.id);
+        result.insert(result.end(), sub.begin(), sub.end());
+    }
+    return result;
+}
+
+static std::vector<YoutubeComment> legacySort(const std::vector<YoutubeComment>& list)
+{
+    std::vector<YoutubeComment> root = legacyGetChildren(list, "root");
+    std::sort(root.begin(), root.end());
+    return root;
+}
+
+static YoutubeComment makeComment(std::string id, std::string parentId, long timestamp)
+{
+    YoutubeComment c;
+    c.id = std::move(id);
+    c.parentId = std::move(parentId);
+    c.text = "Comment text of a typical length, long enough to leave the small string buffer.";
+    c.author = "@author";
+    c.timestamp = timestamp;
+    return c;
+}
+
+// Like YouTube: about a quarter of the comments are replies to a top-level comment
+static std::vector<YoutubeComment> createTree(size_t count)
+{
+    std::mt19937 random(42);
+    std::vector<YoutubeComment> list;
+    list.reserve(count);
+    std::vector<size_t> topLevel;
+    for (size_t i = 0; i < count; ++i)
+    {
+        long timestamp = 1700000000L + static_cast<long>(random() % 1000000);
+        if (topLevel.empty() || random() % 4 != 0)
+        {
+            topLevel.push_back(i);
+            list.push_back(makeComment("c" + std::to_string(i), "root", timestamp));
+        }
+        else
+        {
+            const std::string& parent = list[topLevel[random() % topLevel.size()]].id;
+            list.push_back(makeComment(parent + ".r" + std::to_string(i), parent, timestamp));
+        }
+    }
+    std::shuffle(list.begin(), list.end(), random);
+    return list;
+}
+
+// Every comment replies to the previous one
+static std::vector<YoutubeComment> createChain(size_t count)
+{
+    std::vector<YoutubeComment> list;
+    list.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        list.push_back(makeComment("c" + std::to_string(i), i == 0 ? "root" : "c" + std::to_string(i - 1), static_cast<long>(i)));
+    return list;
+}
+
+template<class F>
+static void report(const std::string& name, size_t count, F sort)
+{
+    size_t allocationsBefore = AllocationCounter::getAllocations();
+    size_t bytesBefore = AllocationCounter::getAllocatedBytes();
+    size_t sorted = 0;
+    double ms = measureMilliseconds([&] { sorted = sort().size(); });
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::setw(9) << count << " comments "
+              << std::fixed << std::setprecision(2) << std::setw(10) << ms << " ms "
+              << std::setw(10) << AllocationCounter::getAllocations() - allocationsBefore << " allocations "
+              << std::setw(8) << (AllocationCounter::getAllocatedBytes() - bytesBefore) / 1024 << " KB"
+              << (sorted == count ? "" : "  LOST COMMENTS") << "\n";
+}
+
+static YoutubeComments toArena(const std::vector<YoutubeComment>& list)
+{
+    YoutubeComments::Builder builder;
+    for (const auto& comment : list)
+        builder.add(comment);
+    return builder.build();
+}
+
+int main()
+{
+    for (size_t count : {1000u, 100000u, 1000000u})
+    {
+        std::vector<YoutubeComment> tree = createTree(count);
+        YoutubeComments arena = toArena(tree);
+        if (count <= 1000)
+        {
+            report("tree, legacy", count, [&] { return legacySort(tree); });
+            if (legacySort(tree).size() != arena.getThreaded().size())
+                std::cout << "DIFFERENT COMMENT COUNT\n";
+        }
+        report("tree, threaded", count, [&] { return arena.getThreaded(); });
+    }
+
+    YoutubeComments chain = toArena(createChain(1000000));
+    report("chain, threaded", chain.size(), [&] { return chain.getThreaded(); });
+    return 0;
+}
@@ -0,0 +1,196 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Throughput of HtmlEscape on comment text, for every implementation the
+// CPU supports, compared with a naive escaper which appends one character
+// at a time. The output of all of them is checked to be the same.
+//
+// Usage: html_escape_benchmark [info.json file or directory]...
+// Without arguments synthetic comments are used. Directories are searched
+// for *.info.json files recursively.
+
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "HtmlBuffer.h"
+#include "HtmlEscape.h"
+#include "YoutubeInfoJson.h"
+
+namespace fs = std::filesystem;
+
+static void naiveEscape(std::string& out, std::string_view text)
+{
+    for (char c : text)
+    {
+        switch (c)
+        {
+        case '&': out += "&amp;"; break;
+        case '<': out += "&lt;"; break;
+        case '>': out += "&gt;"; break;
+        case '"': out += "&quot;"; break;
+        case '\'': out += "&#39;"; break;
+        default: out += c;
+        }
+    }
+}
+
+static void addInfoJson(std::vector<std::string>& texts, const fs::path& file)
+{
+    try
+    {
+        YoutubeInfoJson info = YoutubeInfoJson::load(file);
+        for (auto comment : info.comments)
+        {
+            texts.emplace_back(comment.text);
+            texts.emplace_back(comment.author);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << file << ": " << e.what() << "\n";
+    }
+}
+
+// Mostly plain sentences, some with apostrophes, quotes, emoji or a link
+static std::vector<std::string> createSyntheticComments(size_t count)
+{
+    static const char* SENTENCES[] = {
+        "This video helped me a lot, thank you for making it.",
+        "I don't understand why this has so few views.",
+        "The part at 12:34 is the best one",
+        "Who's watching this in 2025? 🙋",
+        "He said \"it works on my machine\" and left.",
+        "Timestamps: 0:00 intro, 1:23 setup, 4:56 results",
+        "Source: https://example.com/watch?v=abc&t=42s",
+        "Great explanation. Subscribed!",
+        "Můžete přidat české titulky? Díky moc 👍",
+        "The <video> element finally makes sense to me.",
+    };
+    constexpr size_t SENTENCE_COUNT = sizeof(SENTENCES) / sizeof(SENTENCES[0]);
+
+    std::vector<std::string> comments;
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string text;
+        for (size_t s = 0; s < 1 + i % 4; ++s)
+        {
+            if (!text.empty())
+                text += ' ';
+            text += SENTENCES[(i * 7 + s * 3) % SENTENCE_COUNT];
+        }
+        comments.push_back(std::move(text));
+        comments.push_back("@user" + std::to_string(i % 5000));
+    }
+    return comments;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> texts;
+    for (int i = 1; i < argc; ++i)
+    {
+        fs::path path = argv[i];
+        if (fs::is_directory(path))
+        {
+            for (const auto& entry : fs::recursive_directory_iterator(path))
+            {
+                if (entry.is_regular_file() && entry.path().string().ends_with(".info.json"))
+                    addInfoJson(texts, entry.path());
+            }
+        }
+        else
+        {
+            addInfoJson(texts, path);
+        }
+    }
+    if (texts.empty())
+        texts = createSyntheticComments(200000);
+
+    size_t inputBytes = 0;
+    for (const auto& text : texts)
+        inputBytes += text.size();
+
+    std::string expected;
+    for (const auto& text : texts)
+        naiveEscape(expected, text);
+
+    std::cout << texts.size() << " texts, " << std::fixed << std::setprecision(1)
+              << inputBytes / 1024.0 / 1024.0 << " MB, "
+              << std::setprecision(2) << 100.0 * (expected.size() - inputBytes) / inputBytes
+              << " % longer when escaped\n";
+
+    const int rounds = 10;
+    auto report = [&](const std::string& name, double ms, bool ok) {
+        std::cout << std::left << std::setw(10) << name << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(9) << ms << " ms "
+                  << std::setprecision(2) << std::setw(7) << inputBytes * rounds / (ms / 1000.0) / 1e9 << " GB/s"
+                  << (ok ? "" : "  WRONG OUTPUT") << "\n";
+    };
+
+    {
+        std::string out;
+        out.reserve(expected.size());
+        double ms = measureMilliseconds([&] {
+            for (int round = 0; round < rounds; ++round)
+            {
+                out.clear();
+                for (const auto& text : texts)
+                    naiveEscape(out, text);
+            }
+        });
+        report("naive", ms, out == expected);
+    }
+
+    bool allCorrect = true;
+    const std::pair<HtmlEscape::Implementation, const char*> implementations[] = {
+        {HtmlEscape::Implementation::SCALAR, "scalar"},
+        {HtmlEscape::Implementation::SSE2, "SSE2"},
+        {HtmlEscape::Implementation::AVX2, "AVX2"},
+    };
+    for (auto [implementation, name] : implementations)
+    {
+        if (!HtmlEscape::isSupported(implementation))
+        {
+            std::cout << std::left << std::setw(10) << name << "not supported\n";
+            continue;
+        }
+
+        HtmlBuffer out;
+        double ms = measureMilliseconds([&] {
+            for (int round = 0; round < rounds; ++round)
+            {
+                out.clear();
+                for (const auto& text : texts)
+                    HtmlEscape::append(out, text, implementation);
+            }
+        });
+        bool ok = out.equals(expected);
+        allCorrect = allCorrect && ok;
+        report(name, ms, ok);
+    }
+    return allCorrect ? 0 : 1;
+}
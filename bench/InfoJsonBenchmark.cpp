@@ -0,0 +1,145 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Compares the streaming info JSON extraction with the previous
+// read-into-string + DOM parse on synthetic yt-dlp info files.
+//
+// Usage: info_json_benchmark [working directory]
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <nlohmann/json.hpp>
+
+#include "BenchmarkUtils.h"
+#include "YoutubeComment.h"
+#include "YoutubeInfoJson.h"
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+static void writeSyntheticInfoJson(const fs::path& file, size_t targetBytes)
+{
+    std::ofstream ofs(file, std::ios::binary);
+    size_t written = 0;
+    auto put = [&](const std::string& s) {
+        ofs << s;
+        written += s.size();
+    };
+
+    put(R"({"id":"dQw4w9WgXcQ","title":"Synthetic video","channel":"Synthetic channel",)"
+        R"("channel_url":"https://www.youtube.com/channel/UCsynthetic","channel_id":"UCsynthetic",)"
+        R"("thumbnail":"https://i.ytimg.com/vi/dQw4w9WgXcQ/maxresdefault.jpg",)"
+        R"("thumbnails":[{"url":"https://i.ytimg.com/vi/dQw4w9WgXcQ/default.jpg","width":120},)"
+        R"({"url":"https://i.ytimg.com/vi/dQw4w9WgXcQ/mqdefault.jpg","width":320}],)"
+        R"("ext":"mp4","upload_date":"20240101","timestamp":1704067200,"formats":[)");
+
+    // Half of the file are formats, the rest are comments
+    for (int i = 0; written < targetBytes / 2; ++i)
+    {
+        put(std::string(i == 0 ? "" : ",") + R"({"format_id":")" + std::to_string(i)
+            + R"(","url":"https://rr1---sn-synthetic.googlevideo.com/videoplayback?expire=1704067200&ei=)"
+            + std::string(200, 'x') + R"(","ext":"mp4","width":1920,"height":1080,"fps":30.0,)"
+            + R"("http_headers":{"User-Agent":"Mozilla/5.0","Accept":"*/*"},"fragments":[{"duration":5.0},{"duration":5.0}]})");
+    }
+    put(R"(],"requested_formats":[{"format_id":"137"},{"format_id":"140"}],"comments":[)");
+
+    for (int i = 0; written < targetBytes; ++i)
+    {
+        std::string id = "Ugz" + std::to_string(i / 4);
+        std::string parent = "root";
+        if (i % 4 != 0)
+        {
+            parent = id;
+            id += "." + std::to_string(i % 4);
+        }
+        put(std::string(i == 0 ? "" : ",") + R"({"id":")" + id + R"(","parent":")" + parent
+            + R"(","text":"This is a synthetic comment number )" + std::to_string(i)
+            + R"(, long enough to look like a real one.","author":"@user)" + std::to_string(i % 977)
+            + R"(","timestamp":)" + std::to_string(1704067200 + i) + R"(,"like_count":3,"is_favorited":false})");
+    }
+    put("]}");
+}
+
+// The previous YoutubeVideo code path
+static size_t parseWithDom(const fs::path& file)
+{
+    std::ifstream ifs(file);
+    std::stringstream buffer;
+    buffer << ifs.rdbuf();
+    std::string jsonTxt = buffer.str();
+
+    json jsonObject = json::parse(jsonTxt);
+    std::string id = jsonObject.value("id", "");
+    std::string title = jsonObject.value("title", "");
+    std::vector<YoutubeComment> comments;
+    for (auto& elem : jsonObject["comments"])
+        comments.emplace_back(elem);
+    return comments.size() + id.size() + title.size();
+}
+
+static size_t parseWithSax(const fs::path& file)
+{
+    YoutubeInfoJson info = YoutubeInfoJson::load(file);
+    return info.comments.size() + info.id.size() + info.title.size();
+}
+
+int main(int argc, char** argv)
+{
+    fs::path directory = argc > 1 ? fs::path(argv[1]) : fs::temp_directory_path() / "youtube-frontend-info-json-benchmark";
+    fs::create_directories(directory);
+
+    std::cout << std::left << std::setw(8) << "size"
+              << std::setw(8) << "method"
+              << std::setw(14) << "time [ms]"
+              << "peak RSS [MB]\n";
+
+    for (size_t megaBytes : {1, 10, 50})
+    {
+        fs::path file = directory / ("synthetic-" + std::to_string(megaBytes) + "MB.info.json");
+        writeSyntheticInfoJson(file, megaBytes * 1024 * 1024);
+
+        // Checked in a child process too, the parent must stay small
+        if (!runIsolated([&] { return parseWithDom(file) == parseWithSax(file); }).succeeded)
+        {
+            std::cerr << "DOM and SAX extraction differ for " << file << "\n";
+            return 1;
+        }
+
+        for (const char* method : {"dom", "sax"})
+        {
+            bool sax = std::string(method) == "sax";
+            BenchmarkResult result = runIsolated([&] {
+                return (sax ? parseWithSax(file) : parseWithDom(file)) > 0;
+            });
+            std::cout << std::left << std::setw(8) << (std::to_string(megaBytes) + " MB")
+                      << std::setw(8) << method
+                      << std::setw(14) << std::fixed << std::setprecision(1) << result.milliseconds
+                      << result.peakRssKiloBytes / 1024.0 << "\n";
+        }
+        fs::remove(file);
+    }
+    return 0;
+}
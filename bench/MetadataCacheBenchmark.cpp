@@ -0,0 +1,117 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Warm-start load time of the per-snapshot metadata:
+// the old "key=value" text file read with std::getline versus metadata.bin.
+//
+// Usage: metadata_cache_benchmark [working directory] [snapshot count]
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+#include "BenchmarkUtils.h"
+#include "MetadataCache.h"
+#include "YoutubeVideo.h"
+
+namespace fs = std::filesystem;
+
+// The writer used before metadata.bin
+static void writeLegacyText(const fs::path& file, const YoutubeVideo& v)
+{
+    std::ofstream ofs(file);
+    ofs << "id=" << v.id << "\n";
+    ofs << "snapshot=" << v.snapshot << "\n";
+    ofs << "title=" << v.title << "\n";
+    ofs << "videoFileName=" << v.videoFileName << "\n";
+    ofs << "videoFileSizeInBytes=" << v.videoFileSizeInBytes << "\n";
+    ofs << "videoFileSha512HashSum=" << v.videoFileSha512HashSum << "\n";
+    ofs << "videoDuration=" << v.videoDuration << "\n";
+    ofs << "channelName=" << v.channelName << "\n";
+    ofs << "channelUrl=" << v.channelUrl << "\n";
+    ofs << "channelId=" << v.channelId << "\n";
+    ofs << "uploadDate=" << v.uploadDate << "\n";
+    ofs << "timestamp=" << v.timestamp << "\n";
+    ofs << "description=" << v.description << "\n";
+    ofs << "thumbnail=" << v.thumbnail << "\n";
+    ofs << "miniThumbnail=" << v.miniThumbnail << "\n";
+    nlohmann::json comments = nlohmann::json::array();
+    for (auto comment : v.comments)
+    {
+        comments.push_back({{"id", comment.id}, {"parent", comment.parentId}, {"text", comment.text},
+                            {"author", comment.author}, {"timestamp", comment.timestamp}});
+    }
+    ofs << "comments=" << comments.dump() << "\n";
+    ofs << "ext=" << v.ext << "\n";
+    ofs << "number=" << v.number << "\n";
+}
+
+int main(int argc, char** argv)
+{
+    fs::path directory = argc > 1 ? fs::path(argv[1]) : fs::temp_directory_path() / "youtube-frontend-metadata-benchmark";
+    int count = argc > 2 ? std::stoi(argv[2]) : 100000;
+
+    std::vector<fs::path> mediaDirectories;
+    std::vector<YoutubeVideo> videos; // created only when files are missing
+    for (int i = 0; i < count; ++i)
+    {
+        fs::path media = directory / std::to_string(i) / "media";
+        mediaDirectories.push_back(media);
+        if (fs::exists(media / MetadataCache::FILE_NAME))
+            continue;
+        if (videos.empty())
+            videos = createSyntheticVideos(static_cast<size_t>(count), 20, 1000);
+        fs::create_directories(media);
+        writeLegacyText(media / MetadataCache::LEGACY_FILE_NAME, videos[i]);
+        MetadataCache::write(media / MetadataCache::FILE_NAME, videos[i]);
+    }
+    videos.clear();
+
+    auto loadAll = [&](bool binary) {
+        size_t loaded = 0;
+        for (size_t i = 0; i < mediaDirectories.size(); ++i)
+        {
+            YoutubeVideo v;
+            bool ok = binary
+                ? MetadataCache::read(mediaDirectories[i] / MetadataCache::FILE_NAME, v)
+                : MetadataCache::readLegacy(mediaDirectories[i] / MetadataCache::LEGACY_FILE_NAME, v);
+            if (ok && v.description == createSyntheticDescription(i))
+                ++loaded;
+        }
+        return loaded;
+    };
+
+    for (bool binary : {false, true})
+    {
+        loadAll(binary); // warm the page cache
+        size_t loaded = 0;
+        double ms = measureMilliseconds([&] { loaded = loadAll(binary); });
+        std::cout << std::left << std::setw(10) << (binary ? "binary" : "text")
+                  << std::fixed << std::setprecision(1) << ms << " ms, "
+                  << std::setprecision(2) << ms * 1000.0 / count << " us per snapshot, "
+                  << loaded << "/" << count << " loaded intact\n";
+    }
+    return 0;
+}
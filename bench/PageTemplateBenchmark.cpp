@@ -0,0 +1,97 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Render throughput of the compile-time page templates: video pages
+// (HTML5 player and MKV, with and without a description) and channel pages.
+// The pages are compared with the output of the code before the templates by
+// the golden_pages test in test/, not here.
+//
+// Usage: page_template_benchmark [number of videos] [comments per video]
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Args.h"
+#include "Config.h"
+#include "BenchmarkUtils.h"
+#include "ChannelHtml.h"
+#include "ChannelIndex.h"
+#include "YoutubeVideo.h"
+#include "YoutubeVideoHtml.h"
+
+namespace fs = std::filesystem;
+
+static void report(const std::string& name, size_t pages, size_t bytes, double ms)
+{
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(9) << ms << " ms "
+              << std::setprecision(0) << std::setw(10) << pages / (ms / 1000.0) << " pages/s "
+              << std::setprecision(1) << std::setw(8) << bytes / 1024.0 / 1024.0 / (ms / 1000.0) << " MB/s\n";
+}
+
+int main(int argc, char** argv)
+{
+    size_t videoCount = argc > 1 ? std::stoul(argv[1]) : 20000;
+    size_t commentsPerVideo = argc > 2 ? std::stoul(argv[2]) : 20;
+
+    std::vector<YoutubeVideo> videos = createSyntheticVideos(videoCount, commentsPerVideo);
+    ChannelIndex channelIndex(videos);
+    const fs::path root = "/archive-root";
+    const fs::path archive = root / "archive";
+
+    std::cout << videoCount << " videos, " << commentsPerVideo << " comments per video\n";
+
+    size_t bytes = 0;
+    double ms = measureMilliseconds([&] {
+        for (const auto& channel : channelIndex.getChannels())
+        {
+            for (const auto& video : channelIndex.getVideos(channel))
+            {
+                YoutubeVideoHtml html(video, root, archive, static_cast<long>(channel.videoCount));
+                bytes += html.getPage().size();
+            }
+        }
+    });
+    report("video pages", videoCount, bytes, ms);
+
+    Config config(Args({"--videos-per-row", "4"}));
+    const int rounds = 20;
+    size_t channelPages = rounds * channelIndex.getChannels().size();
+
+    bytes = 0;
+    ms = measureMilliseconds([&] {
+        for (int round = 0; round < rounds; ++round)
+        {
+            for (const auto& channel : channelIndex.getChannels())
+            {
+                ChannelHtml html(channelIndex, &channel, config, root);
+                bytes += html.getPage().size();
+            }
+        }
+    });
+    report("channel pages", channelPages, bytes, ms);
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Time and bytes read per duration probe, for the header-only path of
+// MediaProbe against the full stream-info analysis, over all video files
+// of a directory. Bytes are the rchar counter of /proc/self/io, so they
+// include reads served from the page cache.
+//
+// Usage: probe_benchmark <directory with sample videos>
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "MediaProbe.h"
+
+namespace fs = std::filesystem;
+
+static uint64_t getBytesRead()
+{
+    std::ifstream io("/proc/self/io");
+    std::string key;
+    uint64_t value = 0;
+    while (io >> key >> value)
+        if (key == "rchar:")
+            return value;
+    return 0;
+}
+
+struct ProbeTotals {
+    double milliseconds = 0;
+    uint64_t bytes = 0;
+    size_t files = 0;
+};
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: probe_benchmark <directory with sample videos>\n";
+        return 1;
+    }
+
+    std::vector<fs::path> files;
+    for (auto& entry : fs::recursive_directory_iterator(argv[1]))
+    {
+        std::string extension = entry.path().extension().string();
+        if (entry.is_regular_file() && (extension == ".mp4" || extension == ".mkv" || extension == ".webm"))
+            files.push_back(entry.path());
+    }
+
+    ProbeTotals header;
+    ProbeTotals streamInfo;
+
+    auto probe = [](ProbeTotals& totals, auto getDuration, const fs::path& file) {
+        std::optional<int64_t> duration;
+        uint64_t before = getBytesRead();
+        double ms = measureMilliseconds([&] { duration = getDuration(file); });
+        uint64_t bytes = getBytesRead() - before;
+        totals.milliseconds += ms;
+        totals.bytes += bytes;
+        ++totals.files;
+        std::cout << std::right << std::setw(10) << bytes / 1024 << " KB "
+                  << std::fixed << std::setprecision(2) << std::setw(9) << ms << " ms";
+        return duration;
+    };
+
+    for (const auto& file : files)
+    {
+        MediaProbe::getDuration(file); // warm up the page cache
+        std::cout << file.filename().string() << "\n  header:     ";
+        auto fast = probe(header, MediaProbe::getDuration, file);
+        std::cout << "\n  streamInfo: ";
+        auto full = probe(streamInfo, MediaProbe::getDurationFromStreamInfo, file);
+        std::cout << (fast == full ? "" : "  DIFFERENT DURATION") << "\n";
+    }
+
+    auto report = [](const std::string& name, const ProbeTotals& totals) {
+        if (totals.files == 0)
+            return;
+        std::cout << std::left << std::setw(12) << name
+                  << std::fixed << std::setprecision(1)
+                  << static_cast<double>(totals.bytes) / 1024.0 / static_cast<double>(totals.files) << " KB, "
+                  << std::setprecision(3) << totals.milliseconds / static_cast<double>(totals.files) << " ms per probe\n";
+    };
+
+    std::cout << "\n" << files.size() << " files\n";
+    report("header", header);
+    report("streamInfo", streamInfo);
+    return 0;
+}
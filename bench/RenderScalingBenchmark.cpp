@@ -0,0 +1,95 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Scaling of the page rendering stage with the number of threads: every
+// video page, channel page and the master list of a synthetic archive is
+// rendered and written to a temporary directory.
+//
+// Usage: render_scaling_benchmark [number of videos] [comments per video] [directory]
+
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Args.h"
+#include "Config.h"
+#include "BenchmarkUtils.h"
+#include "ChannelIndex.h"
+#include "PageFingerprints.h"
+#include "PageRenderer.h"
+#include "TaskScheduler.h"
+#include "YoutubeVideo.h"
+
+namespace fs = std::filesystem;
+
+int main(int argc, char** argv)
+{
+    size_t videoCount = argc > 1 ? std::stoul(argv[1]) : 20000;
+    size_t commentsPerVideo = argc > 2 ? std::stoul(argv[2]) : 20;
+    fs::path root = argc > 3 ? fs::path(argv[3]) : fs::temp_directory_path() / "youtube-frontend-render-benchmark";
+
+    fs::create_directories(root / "archive");
+    // 100 channels
+    std::vector<YoutubeVideo> videos = createSyntheticVideos(videoCount, commentsPerVideo, 100);
+    ChannelIndex channelIndex(videos);
+    Config config(Args({"--always-generate-html-files", "1"}));
+    PageFingerprints fingerprints(root / "pages.bin");
+
+    std::cout << videoCount << " videos, " << commentsPerVideo << " comments per video\n";
+
+    std::vector<size_t> threadCounts;
+    size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads < hardwareThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(hardwareThreads);
+
+    // The progress lines of the renderer are not part of the output
+    std::ostringstream discarded;
+    double singleThreadMs = 0;
+    for (size_t threads : threadCounts)
+    {
+        size_t pages = 0;
+        TaskScheduler scheduler(threads);
+        std::streambuf* console = std::cout.rdbuf(discarded.rdbuf());
+        std::streambuf* errors = std::cerr.rdbuf(discarded.rdbuf());
+        double ms = measureMilliseconds([&] {
+            pages = PageRenderer(channelIndex, config, root).render(fingerprints, scheduler);
+        });
+        std::cout.rdbuf(console);
+        std::cerr.rdbuf(errors);
+        discarded.str("");
+
+        if (threads == 1)
+            singleThreadMs = ms;
+        std::cout << std::setw(3) << threads << " threads " << std::fixed
+                  << std::setprecision(1) << std::setw(9) << ms << " ms "
+                  << std::setprecision(0) << std::setw(9) << pages / (ms / 1000.0) << " pages/s "
+                  << std::setprecision(2) << std::setw(6) << singleThreadMs / ms << "x\n";
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Overhead of scheduling 1M no-op tasks: the previous ThreadPool with one
+// shared queue, std::function and a future per task, versus TaskScheduler
+// with tasks submitted from the main thread, as one batch, and spawned by
+// the workers themselves.
+//
+// Usage: task_scheduler_benchmark [number of tasks] [threads]
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "BenchmarkUtils.h"
+#include "TaskScheduler.h"
+
+// The pool used before TaskScheduler
+class LegacyThreadPool {
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+
+    std::mutex queueMutex;
+    std::condition_variable condition;
+    bool stop = false;
+
+public:
+    explicit LegacyThreadPool(size_t threads) {
+        for (size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([this] {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(this->queueMutex);
+                        this->condition.wait(lock, [this] {
+                            return this->stop || !this->tasks.empty();
+                        });
+                        if (this->stop && this->tasks.empty())
+                            return;
+                        task = std::move(this->tasks.front());
+                        this->tasks.pop();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    template<class F>
+    auto enqueue(F f) -> std::future<decltype(f())> {
+        auto taskPtr =
+            std::make_shared<std::packaged_task<decltype(f())()>>(std::move(f));
+        std::future<decltype(f())> res = taskPtr->get_future();
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            tasks.emplace([taskPtr] { (*taskPtr)(); });
+        }
+        condition.notify_one();
+        return res;
+    }
+
+    ~LegacyThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stop = true;
+        }
+        condition.notify_all();
+        for (auto &t : workers)
+            t.join();
+    }
+};
+
+int main(int argc, char** argv)
+{
+    size_t taskCount = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    size_t threads = argc > 2 ? std::stoul(argv[2]) : TaskScheduler::getDefaultThreadCount();
+
+    std::atomic<size_t> executed{0};
+    auto noOp = [&executed] { executed.fetch_add(1, std::memory_order_relaxed); };
+
+    auto report = [&](const char* name, auto&& f) {
+        executed = 0;
+        size_t allocationsBefore = AllocationCounter::getAllocations();
+        double ms = measureMilliseconds(f);
+        size_t allocated = AllocationCounter::getAllocations() - allocationsBefore;
+        std::cout << std::left << std::setw(20) << name << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(8) << ms * 1e6 / taskCount << " ns/task "
+                  << std::setprecision(2) << std::setw(6) << double(allocated) / taskCount << " allocations/task"
+                  << (executed.load() == taskCount ? "" : "  WRONG TASK COUNT") << "\n";
+        return executed.load() == taskCount;
+    };
+
+    std::cout << taskCount << " no-op tasks, " << threads << " threads\n";
+    bool ok = true;
+
+    {
+        LegacyThreadPool pool(threads);
+        ok &= report("ThreadPool", [&] {
+            std::vector<std::future<void>> futures;
+            futures.reserve(taskCount);
+            for (size_t i = 0; i < taskCount; ++i)
+                futures.push_back(pool.enqueue(noOp));
+            for (auto& future : futures)
+                future.get();
+        });
+    }
+
+    TaskScheduler scheduler(threads);
+    // The deques grow once, as in a long running program
+    {
+        TaskGroup warmUp(scheduler);
+        warmUp.runBatch(taskCount, [&](size_t) { noOp(); });
+    }
+
+    ok &= report("submit", [&] {
+        TaskGroup group(scheduler);
+        for (size_t i = 0; i < taskCount; ++i)
+            group.run(noOp);
+        group.wait();
+    });
+
+    ok &= report("runBatch", [&] {
+        TaskGroup group(scheduler);
+        group.runBatch(taskCount, [&](size_t) { noOp(); });
+        group.wait();
+    });
+
+    // Every task of the batch submits further tasks to its own deque
+    ok &= report("spawned by workers", [&] {
+        constexpr size_t FAN_OUT = 100;
+        size_t parents = taskCount / FAN_OUT;
+        TaskGroup group(scheduler);
+        group.runBatch(parents, [&](size_t) {
+            for (size_t i = 0; i < FAN_OUT; ++i)
+                group.run(noOp);
+        });
+        group.wait();
+        for (size_t i = parents * FAN_OUT; i < taskCount; ++i)
+            noOp();
+    });
+
+    return ok ? 0 : 1;
+}
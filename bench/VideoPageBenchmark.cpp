@@ -0,0 +1,67 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Size of the video page and generation time for a synthetic video with
+// a huge comment section, with all comments on the page and with paging.
+//
+// Usage: video_page_benchmark [number of comments]
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "BenchmarkUtils.h"
+#include "YoutubeVideo.h"
+#include "YoutubeVideoHtml.h"
+
+static void report(const std::string& name, const YoutubeVideo& video, const CommentPaging& paging)
+{
+    size_t firstPage = 0;
+    size_t total = 0;
+    size_t shards = 0;
+    double ms = measureMilliseconds([&] {
+        YoutubeVideoHtml html(video, "/archive-root", "/archive-root/archive", 1, paging);
+        firstPage = html.getPage().size();
+        total = firstPage;
+        for (const auto& shard : html.getCommentShards())
+            total += shard->size();
+        shards = html.getCommentShards().size();
+    });
+    std::cout << std::left << std::setw(24) << name << std::right
+              << std::setw(12) << firstPage / 1024 << " KB first page "
+              << std::setw(10) << total / 1024 << " KB total "
+              << std::setw(5) << shards << " shards "
+              << std::fixed << std::setprecision(1) << std::setw(9) << ms << " ms\n";
+}
+
+int main(int argc, char** argv)
+{
+    size_t commentCount = argc > 1 ? std::stoul(argv[1]) : 500000;
+    YoutubeVideo video = std::move(createSyntheticVideos(1, commentCount, 1).front());
+    std::cout << commentCount << " comments\n";
+
+    report("all on the page", video, CommentPaging{});
+    report("100 threads, 100 shards", video, CommentPaging{100, 100});
+    report("100 threads, 1000 shards", video, CommentPaging{100, 1000});
+    return 0;
+}
@@ -0,0 +1,81 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <sys/stat.h>
+
+#include "MappedFile.h"
+#include "YoutubeVideo.h"
+
+// Archive-wide metadata store "<root>/.youtube-frontend/index.bin".
+//
+// An append-only log of (snapshot, media directory mtime, metadata record).
+// The last record of a snapshot wins. A record is used only while the
+// mtime of the media directory is unchanged, otherwise the snapshot is
+// loaded the usual way and a new record is appended.
+class ArchiveIndex
+{
+public:
+    static constexpr uint32_t MAGIC = 0x49465459; // "YTFI"
+    static constexpr uint32_t VERSION = 1;
+    static inline const std::string FILE_NAME = "index.bin";
+
+private:
+    struct Entry {
+        int64_t mediaDirectoryMtime;
+        std::string_view record;
+    };
+
+    std::filesystem::path file;
+    std::unique_ptr<MappedFile> mappedFile;
+    std::unordered_map<std::string, Entry> entries;
+    size_t recordCount = 0;
+    bool damaged = false;
+
+    std::string pending;
+    std::unordered_set<std::string> pendingSnapshots;
+    std::unordered_set<std::string> usedSnapshots;
+
+public:
+    explicit ArchiveIndex(const std::filesystem::path& file);
+
+    // Not thread-safe, called from the thread walking the archive directory.
+    // Returns the stored metadata record when it is still valid.
+    std::optional<std::string_view> find(const std::string& snapshot, int64_t mediaDirectoryMtime);
+
+    void add(const std::string& snapshot, int64_t mediaDirectoryMtime, const YoutubeVideo& video);
+
+    // Appends the new records, or rewrites the file when most of it is stale
+    void save();
+
+    static int64_t getMtime(const struct stat& st);
+};
@@ -26,15 +26,36 @@
 #include <array>
 #include <vector>
 
+// Every command line option: enum value, name, C++ type, default value
+// (nullptr = none) and the field of Config it is resolved into.
+// Comments have to be /* */ inside the macro.
+#define YOUTUBE_FRONTEND_ARGS(ARG) \
+    ARG(VIDEO,                      "video",                      std::string, "",      video) \
+    ARG(CHANNEL,                    "channel",                    std::string, "",      channel) \
+    ARG(VIDEOS_PER_ROW,             "videos-per-row",             int,         "4",     videosPerRow) \
+    ARG(ALWAYS_GENERATE_METADATA,   "always-generate-metadata",   bool,        "true",  alwaysGenerateMetadata) \
+    ARG(ALWAYS_GENERATE_HTML_FILES, "always-generate-html-files", bool,        "false", alwaysGenerateHtmlFiles) \
+    ARG(THUMBNAIL_AS_BASE64,        "thumbnail-as-base64",        bool,        "false", thumbnailAsBase64) \
+    ARG(THUMBNAIL_LINKS_TO_YOUTUBE, "thumbnail-links-to-youtube", bool,        "false", thumbnailLinksToYoutube) \
+    ARG(ARCHIVE_INDEX,              "archive-index",              bool,        "false", archiveIndex) \
+    ARG(VERIFY_HASHES,              "verify-hashes",              bool,        "false", verifyHashes) \
+    /* video files read at once per device */ \
+    ARG(IO_CONCURRENCY,             "io-concurrency",             int,         "1",     ioConcurrency) \
+    /* 0 = all comments on the video page */ \
+    ARG(COMMENT_THREADS_PER_PAGE,   "comment-threads-per-page",   int,         "0",     commentThreadsPerPage) \
+    ARG(MAX_COMMENT_SHARDS,         "max-comment-shards",         int,         "100",   maxCommentShards) \
+    /* JSON progress for other programs, "" = none */ \
+    ARG(STATUS_FILE,                "status-file",                std::string, "",      statusFile) \
+    /* thumbnails of the channel pages converted to e.g. webp, "" = as downloaded */ \
+    ARG(THUMBNAIL_FORMAT,           "thumbnail-format",           std::string, "",      thumbnailFormat) \
+    /* widths of the converted thumbnails offered in srcset, comma separated */ \
+    ARG(THUMBNAIL_WIDTHS,           "thumbnail-widths",           std::vector<int>, "250,500", thumbnailWidths)
+
 enum class ArgType
 {
-    VIDEO,
-    CHANNEL,
-    VIDEOS_PER_ROW,
-    ALWAYS_GENERATE_METADATA,
-    ALWAYS_GENERATE_HTML_FILES,
-    THUMBNAIL_AS_BASE64,
-    THUMBNAIL_LINKS_TO_YOUTUBE
+#define YOUTUBE_FRONTEND_ARG_ENUM(TYPE, NAME, CPP_TYPE, DEFAULT_VALUE, FIELD) TYPE,
+    YOUTUBE_FRONTEND_ARGS(YOUTUBE_FRONTEND_ARG_ENUM)
+#undef YOUTUBE_FRONTEND_ARG_ENUM
 };
 
 struct ArgInfo
@@ -43,16 +64,10 @@ struct ArgInfo
     const char* defaultValue; // nullptr = no default
 };
 
-static constexpr std::array<ArgInfo, 7> ARG_INFOS{
-    {
-        {"video", ""},
-        {"channel", ""},
-        {"videos-per-row", "4"},
-        {"always-generate-metadata", "true"},
-        {"always-generate-html-files", "true"},
-        {"thumbnail-as-base64", "false"},
-        {"thumbnail-links-to-youtube", "false"}
-    }
+static constexpr std::array ARG_INFOS{
+#define YOUTUBE_FRONTEND_ARG_INFO(TYPE, NAME, CPP_TYPE, DEFAULT_VALUE, FIELD) ArgInfo{NAME, DEFAULT_VALUE},
+    YOUTUBE_FRONTEND_ARGS(YOUTUBE_FRONTEND_ARG_INFO)
+#undef YOUTUBE_FRONTEND_ARG_INFO
 };
 
 // Helper getters
@@ -42,13 +42,12 @@ private:
 public:
     Args() = default;
 
+    // Throws YoutubedlFrontendException for an unknown option, a missing
+    // value or an option given twice. The values are checked by Config.
     explicit Args(const std::vector<std::string>& args);
 
+    // The raw value, or the default one
     std::optional<std::string> getString(ArgType type) const;
 
-    bool getBool(ArgType type) const;
-
-    std::optional<int> getInt(ArgType type) const;
-
     std::string to_string() const;
 };
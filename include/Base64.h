@@ -0,0 +1,54 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "HtmlBuffer.h"
+
+// Base64 with the standard alphabet and padding, without line breaks (like
+// OpenSSL with BIO_FLAGS_BASE64_NO_NL), written straight into a page.
+// SSSE3 encodes 12 bytes and AVX2 24 bytes at a time: the bytes are split
+// into 6-bit indices with a shuffle and two multiplications, and the indices
+// are turned into characters with a table lookup.
+class Base64
+{
+public:
+    enum class Implementation { SCALAR, SSSE3, AVX2 };
+
+    // The fastest implementation the CPU supports, detected once
+    static Implementation getBest();
+
+    static bool isSupported(Implementation implementation);
+
+    static constexpr size_t getEncodedSize(size_t size) {
+        return (size + 2) / 3 * 4;
+    }
+
+    static void append(HtmlBuffer& out, std::span<const uint8_t> data);
+
+    static void append(HtmlBuffer& out, std::span<const uint8_t> data, Implementation implementation);
+};
@@ -0,0 +1,98 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "YoutubedlFrontendException.h"
+
+// Little helpers for the binary cache files.
+// Numbers are stored in host byte order, the caches are never shared between machines.
+class BinaryWriter {
+private:
+    std::string& out;
+
+public:
+    explicit BinaryWriter(std::string& out) : out(out) {}
+
+    void writeUInt32(uint32_t value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void writeInt64(int64_t value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    // Length-prefixed
+    void writeString(std::string_view value) {
+        writeUInt32(static_cast<uint32_t>(value.size()));
+        out.append(value);
+    }
+};
+
+class BinaryReader {
+private:
+    std::string_view data;
+    size_t position = 0;
+
+    const char* take(size_t count) {
+        if (data.size() - position < count)
+            throw YoutubedlFrontendException("Unexpected end of binary data");
+        const char* p = data.data() + position;
+        position += count;
+        return p;
+    }
+
+public:
+    explicit BinaryReader(std::string_view data) : data(data) {}
+
+    uint32_t readUInt32() {
+        uint32_t value;
+        std::memcpy(&value, take(sizeof(value)), sizeof(value));
+        return value;
+    }
+
+    int64_t readInt64() {
+        int64_t value;
+        std::memcpy(&value, take(sizeof(value)), sizeof(value));
+        return value;
+    }
+
+    // The view points into the read data
+    std::string_view readString() {
+        uint32_t size = readUInt32();
+        return std::string_view(take(size), size);
+    }
+
+    size_t getPosition() const {
+        return position;
+    }
+
+    bool atEnd() const {
+        return position == data.size();
+    }
+};
@@ -0,0 +1,57 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include "Config.h"
+#include "ChannelIndex.h"
+#include "HtmlBuffer.h"
+#include "ThumbnailCache.h"
+#include "ThumbnailDerivatives.h"
+
+// The page of one channel with the grid of its videos, or the master list
+// (videos.html) with the header of every channel.
+class ChannelHtml {
+private:
+    HtmlBuffer::Pooled page;
+
+public:
+    ChannelHtml(
+        const ChannelIndex& channelIndex,
+        const ChannelIndexEntry* wantedChannel, // nullptr = master list
+        const Config& config,
+        const std::filesystem::path& archiveBoxRootDirectory,
+        ThumbnailCache* thumbnailCache = nullptr, // nullptr = inlined thumbnails are resized every time
+        const ThumbnailDerivatives* thumbnailDerivatives = nullptr // nullptr = thumbnails as downloaded
+    );
+
+    const HtmlBuffer& getPage() const {
+        return *page;
+    }
+
+    std::string toString() const {
+        return page->toString();
+    }
+};
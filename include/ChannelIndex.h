@@ -0,0 +1,62 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "YoutubeVideo.h"
+
+struct ChannelIndexEntry {
+    std::string name;
+    std::string url;
+    std::string id;         // part of the URL after "/channel/", or the name
+    size_t firstVideo;      // position of the first video in the sorted list
+    size_t videoCount;
+    std::string firstVideoId;
+    std::string lastVideoId;
+};
+
+// Groups the sorted video list by channel in one pass.
+// Every channel owns a contiguous span of the list, so pages can be
+// rendered without scanning all videos again for each channel.
+class ChannelIndex {
+private:
+    std::vector<YoutubeVideo>& videos;
+    std::vector<ChannelIndexEntry> channels;
+
+public:
+    explicit ChannelIndex(std::vector<YoutubeVideo>& videos);
+
+    // Channels ordered by name, case-insensitive
+    const std::vector<ChannelIndexEntry>& getChannels() const {
+        return channels;
+    }
+
+    std::span<YoutubeVideo> getVideos(const ChannelIndexEntry& channel) const {
+        return std::span<YoutubeVideo>(videos).subspan(channel.firstVideo, channel.videoCount);
+    }
+};
@@ -24,3 +24,10 @@
 #pragma once
 
 constexpr const int THUMBNAIL_WIDTH = 250;
+
+// Directory in the ArchiveBox root for the caches of youtube-frontend
+constexpr const char* STATE_DIRECTORY_NAME = ".youtube-frontend";
+
+// Part of every page fingerprint. Increase it when the generated markup changes,
+// so that incremental runs render all pages again.
+constexpr const int PAGE_FORMAT_VERSION = 3;
@@ -0,0 +1,54 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+typedef struct evp_md_st EVP_MD;
+
+// Hashes whole files with an OpenSSL EVP digest.
+//
+// Large files are read by a separate thread into two aligned buffers,
+// so reading the next chunk overlaps with hashing the current one.
+// The kernel is told the file is read sequentially, and the pages
+// already read are dropped from the page cache again.
+class FileHasher
+{
+public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 4 * 1024 * 1024;
+
+private:
+    const EVP_MD* digest;
+    size_t bufferSize;
+
+public:
+    // The digest is any EVP name, like "sha512", or "blake2b512" for quick change detection
+    explicit FileHasher(const std::string& digestName = "sha512",
+                        size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    // Lowercase hexadecimal digest of the file content, thread-safe
+    std::string hashFile(const std::filesystem::path& file) const;
+};
@@ -0,0 +1,96 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// SHA-512 sums of files from previous runs, stored in
+// "<root>/.youtube-frontend/hashes.bin" for the video files (the thumbnails
+// use a cache of their own). A file is identified by
+// device, inode, size and mtime, so unchanged files are never read again.
+//
+// In verify mode every file is hashed again (once per run)
+// and differences to the stored sums are collected as mismatches.
+class HashCache
+{
+public:
+    static constexpr uint32_t MAGIC = 0x48465459; // "YTFH"
+    static constexpr uint32_t VERSION = 1;
+    static inline const std::string FILE_NAME = "hashes.bin";
+
+private:
+    struct Key {
+        uint64_t device;
+        uint64_t inode;
+        int64_t size;
+        int64_t mtime;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return std::hash<uint64_t>()(key.device * 31 + key.inode)
+                 ^ std::hash<int64_t>()(key.size * 31 + key.mtime);
+        }
+    };
+
+    std::filesystem::path file;
+    std::string description; // of the hashed files, for the warnings
+    bool verify;
+
+    std::mutex mutex;
+    std::unordered_map<Key, std::string, KeyHash> hashes;
+    std::unordered_set<Key, KeyHash> verified;
+    std::unordered_set<Key, KeyHash> seen; // looked up in this run
+    std::vector<std::string> mismatches;
+    bool changed = false;
+
+public:
+    // The description names the hashed files in warnings, e.g. "video files"
+    HashCache(const std::filesystem::path& file, std::string description, bool verify);
+
+    // Thread-safe, hashed is set when the file had to be read
+    std::string getSha512Hash(const std::filesystem::path& videoFile, bool* hashed = nullptr);
+
+    // Thread-safe
+    void reportMismatch(const std::string& message);
+
+    bool isVerifying() const {
+        return verify;
+    }
+
+    const std::vector<std::string>& getMismatches() const {
+        return mismatches;
+    }
+
+    // dropUnseen: the run looked up every file, the sums of all others are stale
+    void save(bool dropUnseen = false);
+};
@@ -0,0 +1,129 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Output buffer of a generated page. Text is appended to chunks which grow
+// geometrically, so nothing written before is ever moved. The chunks are
+// written to the file with one writev() call, without joining them first.
+//
+// Buffers are reused: acquire() takes a cleared buffer from the pool of the
+// calling thread, and it goes back to a pool when released.
+class HtmlBuffer
+{
+public:
+    struct Release {
+        void operator()(HtmlBuffer* buffer) const;
+    };
+
+    using Pooled = std::unique_ptr<HtmlBuffer, Release>;
+
+private:
+    static constexpr size_t FIRST_CHUNK_SIZE = 64 * 1024;
+    // A released buffer keeps at most this much memory in the pool
+    static constexpr size_t MAX_POOLED_CAPACITY = 16 * 1024 * 1024;
+
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        size_t capacity;
+        size_t size = 0;
+    };
+
+    std::vector<Chunk> chunks;
+    size_t current = 0; // chunk being written
+    size_t totalSize = 0;
+    size_t totalCapacity = 0;
+
+    void nextChunk();
+
+public:
+    HtmlBuffer() = default;
+
+    HtmlBuffer(const HtmlBuffer&) = delete;
+    HtmlBuffer& operator=(const HtmlBuffer&) = delete;
+
+    static Pooled acquire();
+
+    void append(std::string_view text);
+
+    HtmlBuffer& operator<<(std::string_view text) {
+        append(text);
+        return *this;
+    }
+
+    HtmlBuffer& operator<<(char c) {
+        append(std::string_view(&c, 1));
+        return *this;
+    }
+
+    template<std::integral T>
+        requires (!std::same_as<T, char> && !std::same_as<T, bool>)
+    HtmlBuffer& operator<<(T value) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        append(std::string_view(digits, result.ptr));
+        return *this;
+    }
+
+    // Like std::fixed with std::setprecision(precision)
+    HtmlBuffer& appendFixed(double value, int precision);
+
+    // Free space of at least minimum bytes at the end of the current chunk,
+    // nullptr when it has less. The text written there is added by commit().
+    char* getFreeSpace(size_t minimum) {
+        if (chunks.empty())
+            nextChunk();
+        Chunk& chunk = chunks[current];
+        return chunk.capacity - chunk.size >= minimum ? chunk.data.get() + chunk.size : nullptr;
+    }
+
+    void commit(size_t size) {
+        chunks[current].size += size;
+        totalSize += size;
+    }
+
+    size_t size() const {
+        return totalSize;
+    }
+
+    // Keeps the chunks for the next page
+    void clear();
+
+    std::string toString() const;
+
+    bool equals(std::string_view text) const;
+
+    void writeToFile(const std::filesystem::path& file) const;
+
+    // Keeps the file untouched when it already has the same content, returns true when written
+    bool writeToFileIfChanged(const std::filesystem::path& file) const;
+};
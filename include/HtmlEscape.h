@@ -0,0 +1,48 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "HtmlBuffer.h"
+
+// Escapes & < > " ' in text inserted into a page, in element content and in
+// attribute values. The characters are searched for 16 (SSE2) or 32 (AVX2)
+// bytes at a time and the clean runs between them are appended in bulk,
+// so text without them costs little more than a copy.
+class HtmlEscape
+{
+public:
+    enum class Implementation { SCALAR, SSE2, AVX2 };
+
+    // The fastest implementation the CPU supports, detected once
+    static Implementation getBest();
+
+    static bool isSupported(Implementation implementation);
+
+    static void append(HtmlBuffer& out, std::string_view text);
+
+    static void append(HtmlBuffer& out, std::string_view text, Implementation implementation);
+};
@@ -0,0 +1,263 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "HtmlBuffer.h"
+#include "HtmlEscape.h"
+
+// Page layouts are written as text with named slots, "<h1>{{name}}</h1>".
+// The value of a {{text}} slot is HTML-escaped, a {{{raw}}} slot inserts
+// markup as it is. The text is split into static segments and slots at
+// compile time, so rendering copies every segment with one append and
+// formats the slot values in between. A slot without a value, a value
+// without a slot and an unterminated slot are compile errors.
+//
+//     using Heading = html::Template<"<h1>{{name}}</h1>">;
+//     Heading::render(out, html::arg<"name">(channel.name));
+namespace html
+{
+
+template<size_t N>
+struct FixedString {
+    char text[N] {};
+
+    consteval FixedString(const char (&source)[N]) {
+        for (size_t i = 0; i < N; ++i)
+            text[i] = source[i];
+    }
+
+    constexpr std::string_view view() const {
+        return std::string_view(text, N - 1);
+    }
+};
+
+// Value of the slots with the given name
+template<FixedString NAME, class T>
+struct Arg {
+    static constexpr std::string_view name = NAME.view();
+    const T& value;
+};
+
+template<FixedString NAME, class T>
+Arg<NAME, T> arg(const T& value) {
+    return Arg<NAME, T>{value};
+}
+
+// Like std::fixed with std::setprecision(precision)
+struct Fixed {
+    double value;
+    int precision;
+};
+
+inline void write(HtmlBuffer& out, std::string_view value) {
+    out.append(value);
+}
+
+template<std::integral T>
+    requires (!std::same_as<T, char> && !std::same_as<T, bool>)
+void write(HtmlBuffer& out, T value) {
+    out << value;
+}
+
+inline void write(HtmlBuffer& out, const Fixed& value) {
+    out.appendFixed(value.value, value.precision);
+}
+
+// A value which writes itself into the page, like an inlined image.
+// In a text slot it is responsible for its own escaping.
+template<class T>
+concept SelfWriting = requires(const T& value, HtmlBuffer& out) {
+    value.appendTo(out);
+};
+
+template<SelfWriting T>
+void write(HtmlBuffer& out, const T& value) {
+    value.appendTo(out);
+}
+
+// Value of a text slot
+inline void writeText(HtmlBuffer& out, std::string_view value) {
+    HtmlEscape::append(out, value);
+}
+
+// Numbers need no escaping, self-writing values escape themselves
+template<class T>
+    requires (!std::convertible_to<const T&, std::string_view>)
+void writeText(HtmlBuffer& out, const T& value) {
+    write(out, value);
+}
+
+// Text slots escape the value, raw slots insert markup as it is
+struct Slot {
+    std::string_view name;
+    bool raw = false;
+};
+
+// Position of a slot in the template text
+struct SlotSyntax {
+    size_t begin; // of "{{"
+    size_t end;   // after "}}"
+    Slot slot;
+};
+
+// The first slot at or after position, or nothing
+consteval std::optional<SlotSyntax> findSlot(std::string_view source, size_t position) {
+    size_t begin = source.find("{{", position);
+    if (begin == std::string_view::npos)
+        return std::nullopt;
+
+    bool raw = source.substr(begin).starts_with("{{{");
+    std::string_view close = raw ? "}}}" : "}}";
+    size_t nameBegin = begin + (raw ? 3 : 2);
+    size_t nameEnd = source.find(close, nameBegin);
+    if (nameEnd == std::string_view::npos)
+        throw "Unterminated slot in an HTML template";
+
+    std::string_view name = source.substr(nameBegin, nameEnd - nameBegin);
+    if (name.empty())
+        throw "Slot without a name in an HTML template";
+    for (char c : name) {
+        if (!(c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')))
+            throw "Invalid slot name in an HTML template";
+    }
+    return SlotSyntax{begin, nameEnd + close.size(), Slot{name, raw}};
+}
+
+template<FixedString SOURCE>
+class Template
+{
+private:
+    static consteval size_t countSlots() {
+        size_t count = 0;
+        for (auto slot = findSlot(SOURCE.view(), 0); slot; slot = findSlot(SOURCE.view(), slot->end))
+            ++count;
+        return count;
+    }
+
+public:
+    static constexpr size_t SLOT_COUNT = countSlots();
+
+private:
+    struct Parsed {
+        // segments[i] is followed by slots[i], the last segment by nothing
+        std::array<std::string_view, SLOT_COUNT + 1> segments;
+        std::array<Slot, SLOT_COUNT> slots;
+    };
+
+    static consteval Parsed parse() {
+        std::string_view source = SOURCE.view();
+        Parsed parsed {};
+        size_t position = 0;
+        for (size_t i = 0; i < SLOT_COUNT; ++i) {
+            SlotSyntax syntax = *findSlot(source, position);
+            parsed.segments[i] = source.substr(position, syntax.begin - position);
+            parsed.slots[i] = syntax.slot;
+            position = syntax.end;
+        }
+        parsed.segments[SLOT_COUNT] = source.substr(position);
+        return parsed;
+    }
+
+    static constexpr Parsed PARSED = parse();
+
+    // Index of the argument of every slot, sizeof...(Args) when it has none
+    template<class... Args>
+    static consteval std::array<size_t, SLOT_COUNT> findArguments() {
+        std::array<std::string_view, sizeof...(Args)> names {Args::name...};
+        std::array<size_t, SLOT_COUNT> arguments {};
+        for (size_t slot = 0; slot < SLOT_COUNT; ++slot) {
+            arguments[slot] = names.size();
+            for (size_t i = 0; i < names.size(); ++i) {
+                if (names[i] == PARSED.slots[slot].name)
+                    arguments[slot] = i;
+            }
+        }
+        return arguments;
+    }
+
+    template<class... Args>
+    static consteval bool everySlotHasArgument() {
+        for (size_t argument : findArguments<Args...>()) {
+            if (argument == sizeof...(Args))
+                return false;
+        }
+        return true;
+    }
+
+    template<class... Args>
+    static consteval bool everyArgumentHasSlot() {
+        std::array<std::string_view, sizeof...(Args)> names {Args::name...};
+        for (size_t i = 0; i < names.size(); ++i) {
+            bool found = false;
+            for (const Slot& slot : PARSED.slots)
+                found = found || slot.name == names[i];
+            for (size_t j = 0; j < i; ++j) {
+                if (names[j] == names[i])
+                    return false;
+            }
+            if (!found)
+                return false;
+        }
+        return true;
+    }
+
+    template<size_t I>
+    static void appendSegment(HtmlBuffer& out) {
+        if constexpr (!PARSED.segments[I].empty())
+            out.append(PARSED.segments[I]);
+    }
+
+    template<size_t I, class T>
+    static void appendSlot(HtmlBuffer& out, const T& value) {
+        if constexpr (PARSED.slots[I].raw)
+            write(out, value);
+        else
+            writeText(out, value);
+    }
+
+    template<class... Args, size_t... I>
+    static void renderSlots(HtmlBuffer& out, const std::tuple<const Args&...>& args, std::index_sequence<I...>) {
+        [[maybe_unused]] constexpr std::array<size_t, SLOT_COUNT> arguments = findArguments<Args...>();
+        ((appendSegment<I>(out), appendSlot<I>(out, std::get<arguments[I]>(args).value)), ...);
+    }
+
+public:
+    template<class... Args>
+    static void render(HtmlBuffer& out, const Args&... args) {
+        static_assert(everySlotHasArgument<Args...>(), "A slot of the HTML template has no value");
+        static_assert(everyArgumentHasSlot<Args...>(), "A value has no slot in the HTML template, or it is given twice");
+        renderSlots(out, std::tuple<const Args&...>(args...), std::make_index_sequence<SLOT_COUNT>());
+        appendSegment<SLOT_COUNT>(out);
+    }
+};
+
+} // namespace html
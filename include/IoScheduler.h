@@ -0,0 +1,83 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <queue>
+
+#include "TaskScheduler.h"
+
+// Runs the I/O heavy jobs (hashing and probing of video files) with a limited
+// number of concurrent jobs per device, so that a spinning disk reads one
+// file after another instead of seeking between many of them.
+// The jobs run on the shared TaskScheduler, devices are used in parallel.
+class IoScheduler
+{
+public:
+    // A job returns the number of bytes it has read, for the statistics.
+    // It must not throw.
+    using Job = std::function<uint64_t()>;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Device {
+        std::queue<Job> jobs;
+        size_t running = 0;
+        size_t jobCount = 0;
+        uint64_t bytes = 0;
+        Clock::time_point firstStart;
+        Clock::time_point lastEnd;
+    };
+
+    TaskScheduler& scheduler;
+    size_t concurrencyPerDevice;
+    std::mutex mutex;
+    std::condition_variable idle;
+    std::map<uint64_t, std::unique_ptr<Device>> devices;
+    size_t running = 0; // jobs of all devices
+
+    void start(Device& device, Job job);
+    void run(Device& device, Job& job);
+
+public:
+    IoScheduler(TaskScheduler& scheduler, size_t concurrencyPerDevice);
+    ~IoScheduler(); // waits for all jobs
+
+    IoScheduler(const IoScheduler&) = delete;
+    IoScheduler& operator=(const IoScheduler&) = delete;
+
+    // The device is the st_dev of the file the job reads
+    void submit(uint64_t device, Job job);
+
+    // Read throughput of every device so far
+    void printStatistics(std::ostream& out);
+};
@@ -0,0 +1,70 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "YoutubeVideo.h"
+
+// Binary cache of the YoutubeVideo fields, stored as "media/metadata.bin".
+//
+// Layout: magic, version, then every field in declaration order.
+// Strings are length-prefixed, so multi-line descriptions survive,
+// and comments are stored inline after the scalar fields.
+class MetadataCache
+{
+public:
+    static constexpr uint32_t MAGIC = 0x4d465459; // "YTFM"
+    static constexpr uint32_t VERSION = 3; // 2: comments in threaded order, 3: with depth, parent and reply count
+
+    static inline const std::string FILE_NAME = "metadata.bin";
+    static inline const std::string LEGACY_FILE_NAME = "metadata";
+
+    // Bytes read by readIds() before it falls back to the whole file
+    static constexpr size_t IDS_PREFIX_SIZE = 4096;
+
+    MetadataCache() = delete;
+
+    static std::string serialize(const YoutubeVideo& video);
+
+    // Returns false for data of another format or version
+    static bool deserialize(std::string_view data, YoutubeVideo& video);
+
+    // Returns false when the file is missing, outdated or damaged
+    static bool read(const std::filesystem::path& file, YoutubeVideo& video);
+
+    // Reads only the video id and the channel id, used to filter snapshots
+    // before loading them. Returns false like deserialize() and read().
+    static bool deserializeIds(std::string_view data, std::string& id, std::string& channelId);
+    static bool readIds(const std::filesystem::path& file, std::string& id, std::string& channelId);
+
+    static void write(const std::filesystem::path& file, const YoutubeVideo& video);
+
+    // Reads the old "key=value" text file, used only to migrate it
+    static bool readLegacy(const std::filesystem::path& file, YoutubeVideo& video);
+};
@@ -0,0 +1,90 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+// 64-bit FNV-1a hash of the inputs a generated page depends on
+class Fingerprint {
+private:
+    uint64_t hash = 14695981039346656037ULL;
+
+    void addBytes(const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+
+public:
+    Fingerprint& add(std::string_view value) {
+        add(static_cast<int64_t>(value.size()));
+        addBytes(value.data(), value.size());
+        return *this;
+    }
+
+    Fingerprint& add(int64_t value) {
+        addBytes(&value, sizeof(value));
+        return *this;
+    }
+
+    uint64_t get() const {
+        return hash;
+    }
+};
+
+// Fingerprints of the generated pages from the previous run,
+// stored in "<root>/.youtube-frontend/pages.bin".
+// A page is rendered again only when its fingerprint changed.
+class PageFingerprints
+{
+public:
+    static constexpr uint32_t MAGIC = 0x50465459; // "YTFP"
+    static constexpr uint32_t VERSION = 1;
+    static inline const std::string FILE_NAME = "pages.bin";
+
+private:
+    std::filesystem::path file;
+    std::unordered_map<std::string, uint64_t> fingerprints;
+    std::unordered_set<std::string> seen; // updated in this run
+    bool changed = false;
+
+public:
+    explicit PageFingerprints(const std::filesystem::path& file);
+
+    // The page is the path relative to the ArchiveBox root, like "videos/<id>.html"
+    bool isUpToDate(const std::string& page, uint64_t fingerprint) const;
+
+    // Called for every page of the run, also for the ones which were skipped
+    void update(const std::string& page, uint64_t fingerprint);
+
+    // dropUnseen: the run covered every page, the others were removed from the archive
+    void save(bool dropUnseen = false);
+};
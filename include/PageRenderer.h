@@ -0,0 +1,58 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include "Config.h"
+#include "ChannelIndex.h"
+#include "PageFingerprints.h"
+#include "TaskScheduler.h"
+#include "YoutubeVideoHtml.h"
+
+// Renders the page of every video, every channel and the master list.
+// Every page is an independent task on the scheduler: it reads only the
+// loaded videos and the fingerprints of the previous run, and it writes
+// only its own files. The fingerprints are updated afterwards in the order
+// of the pages, so the result does not depend on the scheduling. With
+// --thumbnail-format the thumbnails are converted first, in the same way.
+// Progress goes to stderr and the --status-file.
+class PageRenderer {
+private:
+    const ChannelIndex& channelIndex;
+    const Config& config;
+    std::filesystem::path archiveBoxRootDirectory;
+    CommentPaging commentPaging;
+    bool alwaysGenerateHtmlFiles;
+
+public:
+    PageRenderer(
+        const ChannelIndex& channelIndex,
+        const Config& config,
+        const std::filesystem::path& archiveBoxRootDirectory
+    );
+
+    // Returns the number of rendered pages, unchanged pages are skipped
+    size_t render(PageFingerprints& pageFingerprints, TaskScheduler& scheduler);
+};
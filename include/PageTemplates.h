@@ -0,0 +1,163 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include "HtmlTemplate.h"
+
+// Layout of the generated pages. The C++ code only decides which of the
+// pieces are rendered and with which values.
+namespace PageTemplates
+{
+
+// ------------------- video page -----------------------
+
+// favicon is relative to the page, script is empty or COMMENTS_SCRIPT
+using VideoPageHead = html::Template<R"(<!DOCTYPE html>
+<html>
+<head>
+<meta charset="UTF-8">
+<link rel="icon" type="image/x-icon" href="{{favicon}}" sizes="16x16">
+<title>{{title}}</title>
+<style>
+body {padding:20px;}
+* { font-family:Arial; }
+</style>
+{{{script}}}</head>
+<body>
+)">;
+
+using VideoUrl = html::Template<R"(<input type="text" id="youtube_url" name="youtube_url" size="60" width="60" style="margint-bottom:20px;margin-right:10px;font-size:110%;padding:5px;" value="{{url}}"><br><br>
+<a target="_blank" href="{{url}}">{{url}}</a><br>
+)">;
+
+using VideoPlayer = html::Template<R"(<video src="../archive/{{snapshot}}/media/{{file}}" controls height="440px">Your browser does not support the video tag.</video><br>
+)">;
+
+// Browsers do not play MKV, the thumbnail links to the local file
+using VideoThumbnail = html::Template<R"(<a target="_blank" href="{{localUrl}}"><img style="margin:10px;height:500px;" src="../archive/{{snapshot}}/media/thumbnail.{{thumbnailFormat}}"></a><br>
+)">;
+
+// A disabled button gets "disabled" and "visibility:hidden;", an enabled one empty values
+using VideoNavigation = html::Template<R"(<span style="font-size:200%;font-weight:bold;">{{title}}</span><br><br>
+#{{number}}&nbsp;&nbsp;&nbsp;<button {{backDisabled}} style="{{backHidden}}font-size:200%;" onclick="window.location ='./{{previousId}}.html'">Back</button>&nbsp;&nbsp;&nbsp;<button {{nextDisabled}} style="{{nextHidden}}font-size:200%;" onclick="window.location ='./{{nextId}}.html'">Next</button> <br><br><a href="../archive/{{snapshot}}/media/{{file}}">Download</a> {{sizeInMegaBytes}} MB )">;
+
+using VideoConvertCommand = html::Template<R"(<input type="text" size="100" style="margin-bottom:20px;margin-right:10px;font-size:110%;padding:5px;" value="cd {{mediaDirectory}} && ffmpeg -i {{file}} -preset slow -crf 18 {{webmFile}}"><br>)">;
+
+using VideoMediaDirectory = html::Template<R"(<input type="text" size="100" style="margin-bottom:20px;margin-right:10px;font-size:110%;padding:5px;" value="{{mediaDirectory}}"><br>)">;
+
+using VideoDescription = html::Template<R"(<br><br><br>
+<pre style="white-space: pre-wrap; border:1px solid black;max-width:600px;padding:10px;min-height:50px;">{{description}}</pre><h2>Comments</h2>)">;
+
+using Comment = html::Template<R"(<div style="margin-left:{{indent}}px;"><h3>{{author}}</h3><span style="color:grey;font-size:80%;">{{date}}</span><br>
+<span style="color:grey;font-size:80%;">{{id}} {{parentId}}</span><br>
+<pre style="white-space: pre-wrap;border:1px solid black;max-width:600px;padding:10px;min-height:50px;">{{text}}</pre></div>)">;
+
+using LoadMoreComments = html::Template<R"html(<div id="comments-more"><a href="{{href}}" onclick="return loadComments(this)">Load more comments</a></div>)html">;
+
+// Replaces the link with the comments of the shard it points to. The next
+// link is relative to the shard. Browsers which do not allow fetch() for
+// local files open the shard instead.
+constexpr std::string_view COMMENTS_SCRIPT = R"(<script>
+function loadComments(link) {
+    fetch(link.href).then(function (response) {
+        if (!response.ok)
+            throw new Error(response.statusText);
+        return response.text();
+    }).then(function (text) {
+        var shard = new DOMParser().parseFromString(text, "text/html");
+        var next = shard.querySelector("#comments-more a");
+        if (next)
+            next.href = new URL(next.getAttribute("href"), link.href).href;
+        link.parentNode.replaceWith(...shard.getElementById("comments").childNodes);
+    }).catch(function () {
+        window.location = link.href;
+    });
+    return false;
+}
+</script>
+)";
+
+using VideoPageEnd = html::Template<"</body></html>">;
+
+// ------------------- comment shard -----------------------
+
+// Follows VideoPageHead
+using CommentShardBegin = html::Template<R"(<a href="../{{videoId}}.html">Back to the video</a>
+<div id="comments">)">;
+
+using CommentShardEnd = html::Template<"</div></body></html>">;
+
+// ------------------- channel page and master list -----------------------
+
+using ChannelPageHead = html::Template<R"(<!DOCTYPE html>
+<html>
+<head>
+<meta charset="UTF-8">
+<link rel="icon" type="image/x-icon" href="favicon.ico" sizes="16x16">
+<title>Youtube videos</title>
+<!-- Generated by: https://code.openeggbert.org/openeggbert/youtubedl-frontend -->
+<style>
+body {padding:20px;}
+* { font-family:Arial; }
+.videos { }
+.box { padding:10px; }
+</style>
+</head>
+<body>
+)">;
+
+// Left open, closed by ChannelEnd
+using ChannelBegin = html::Template<R"(<h1>{{name}}</h1>
+<div style="max-width:{{maxWidth}}px"><a target="_blank" href="channels/{{id}}.html">Videos</a>&nbsp;&nbsp;&nbsp;( <a href="{{url}}">{{url}}</a> ))">;
+
+using VideoGridBegin = html::Template<R"(<div class="videos"><table>
+)">;
+
+using VideoGridRow = html::Template<"<tr>">;
+
+// Left open for one of the thumbnails below, closed by VideoGridCellEnd
+using VideoGridCellBegin = html::Template<R"(<td><div class="box"><table style="margin:5px;max-width:{{thumbnailWidth}}px;">
+<tr><td><a href="{{linkPrefix}}{{id}}{{linkSuffix}}" target="_blank">)">;
+
+using VideoGridThumbnail = html::Template<R"(<img src="{{thumbnail}}" width="{{thumbnailWidth}}">)">;
+
+// Converted thumbnails (--thumbnail-format), the browser picks the width
+using VideoGridThumbnailSet = html::Template<R"(<img src="{{thumbnail}}" srcset="{{srcset}}" sizes="{{thumbnailWidth}}px" width="{{thumbnailWidth}}" height="{{thumbnailHeight}}" loading="lazy">)">;
+
+using VideoGridCellEnd = html::Template<R"(</a></td></tr>
+<tr><td><b style="font-size:90%;">{{title}}</b></td></tr>
+<tr><td style="font-size:80%;color:grey;">{{uploadDate}} •︎ {{duration}} •︎ #{{number}}</td></tr>
+</table></div></td>
+)">;
+
+using VideoGridEnd = html::Template<R"(</table>
+</div>)">;
+
+using ChannelEnd = html::Template<"</div>">;
+
+using ChannelPageEnd = html::Template<"</body></html>">;
+
+} // namespace PageTemplates
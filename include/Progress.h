@@ -0,0 +1,87 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+// Progress of one stage (loading, rendering), advanced from any thread.
+//
+// advance() only increments an atomic counter and reads the clock; at most
+// once per REPORT_INTERVAL one of the callers prints a line with throughput
+// and ETA and rewrites the status file. Nothing else touches the filesystem.
+class Progress
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::chrono::milliseconds REPORT_INTERVAL {1000};
+
+private:
+    std::string stage;
+    std::string unit;
+    std::ostream& out;
+    std::filesystem::path statusFile;
+    Clock::time_point start;
+
+    std::atomic<size_t> total;
+    std::atomic<size_t> done {0};
+    std::atomic<int64_t> nextReport; // in Clock ticks since start
+    std::mutex reportMutex;
+
+    void report(bool finished);
+    void writeStatusFile(size_t doneNow, size_t totalNow, double seconds, bool finished);
+
+public:
+    // total 0 = not known yet, see setTotal(). An empty statusFile is not written.
+    Progress(std::string stage, std::string unit, size_t total,
+             std::ostream& out, std::filesystem::path statusFile);
+
+    Progress(const Progress&) = delete;
+    Progress& operator=(const Progress&) = delete;
+
+    void setTotal(size_t count) {
+        total.store(count);
+    }
+
+    void advance(size_t count = 1) {
+        done.fetch_add(count, std::memory_order_relaxed);
+        int64_t now = (Clock::now() - start).count();
+        int64_t next = nextReport.load(std::memory_order_relaxed);
+        if (now >= next && nextReport.compare_exchange_strong(next, now + Clock::duration(REPORT_INTERVAL).count()))
+            report(false);
+    }
+
+    size_t getDone() const {
+        return done.load();
+    }
+
+    // Prints the summary line and the final status
+    void finish();
+};
@@ -0,0 +1,324 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Work-stealing scheduler shared by loading, hashing, probing and rendering.
+//
+// Every worker owns a deque: it pushes and pops its own tasks at the back,
+// idle workers steal half of the tasks of another worker from the front.
+// Tasks are stored inline in the deques, so submitting a task whose
+// captures fit into Task::CAPACITY bytes does not allocate once the deques
+// have grown. Idle workers sleep until a task is submitted.
+class TaskScheduler
+{
+public:
+    class Task
+    {
+    public:
+        static constexpr size_t CAPACITY = 56;
+
+    private:
+        struct Operations {
+            void (*run)(void* storage);
+            void (*move)(void* from, void* to); // destroys from
+            void (*destroy)(void* storage);
+        };
+
+        template<class F>
+        static constexpr bool STORED_INLINE = sizeof(F) <= CAPACITY
+            && alignof(F) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible_v<F>;
+
+        template<class F>
+        struct Inline {
+            static void run(void* storage) {
+                (*static_cast<F*>(storage))();
+            }
+            static void move(void* from, void* to) {
+                ::new (to) F(std::move(*static_cast<F*>(from)));
+                static_cast<F*>(from)->~F();
+            }
+            static void destroy(void* storage) {
+                static_cast<F*>(storage)->~F();
+            }
+            static constexpr Operations OPERATIONS {run, move, destroy};
+        };
+
+        // Larger callables are kept on the heap
+        template<class F>
+        struct Boxed {
+            static void run(void* storage) {
+                (**static_cast<F**>(storage))();
+            }
+            static void move(void* from, void* to) {
+                *static_cast<F**>(to) = *static_cast<F**>(from);
+            }
+            static void destroy(void* storage) {
+                delete *static_cast<F**>(storage);
+            }
+            static constexpr Operations OPERATIONS {run, move, destroy};
+        };
+
+        alignas(std::max_align_t) unsigned char storage[CAPACITY];
+        const Operations* operations = nullptr;
+
+    public:
+        Task() = default;
+
+        template<class F>
+            requires (!std::is_same_v<std::decay_t<F>, Task>)
+        Task(F&& f) {
+            using Callable = std::decay_t<F>;
+            if constexpr (STORED_INLINE<Callable>) {
+                ::new (storage) Callable(std::forward<F>(f));
+                operations = &Inline<Callable>::OPERATIONS;
+            } else {
+                *reinterpret_cast<Callable**>(storage) = new Callable(std::forward<F>(f));
+                operations = &Boxed<Callable>::OPERATIONS;
+            }
+        }
+
+        Task(Task&& other) noexcept {
+            *this = std::move(other);
+        }
+
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                reset();
+                if (other.operations) {
+                    other.operations->move(other.storage, storage);
+                    operations = std::exchange(other.operations, nullptr);
+                }
+            }
+            return *this;
+        }
+
+        ~Task() {
+            reset();
+        }
+
+        void reset() {
+            if (operations) {
+                operations->destroy(storage);
+                operations = nullptr;
+            }
+        }
+
+        // Runs the task once, it is empty afterwards
+        void operator()() {
+            struct Reset {
+                Task& task;
+                ~Reset() { task.reset(); }
+            } reset {*this};
+            operations->run(storage);
+        }
+
+        explicit operator bool() const {
+            return operations != nullptr;
+        }
+    };
+
+private:
+    // Ring buffer of tasks, it only grows
+    class Deque
+    {
+    private:
+        std::unique_ptr<Task[]> tasks;
+        size_t capacity = 0;
+        size_t head = 0;
+        size_t count = 0;
+
+        void grow();
+
+    public:
+        bool empty() const {
+            return count == 0;
+        }
+
+        size_t size() const {
+            return count;
+        }
+
+        void pushBack(Task&& task) {
+            if (count == capacity)
+                grow();
+            tasks[(head + count++) & (capacity - 1)] = std::move(task);
+        }
+
+        Task popBack() {
+            return std::move(tasks[(head + --count) & (capacity - 1)]);
+        }
+
+        Task popFront() {
+            Task task = std::move(tasks[head]);
+            head = (head + 1) & (capacity - 1);
+            --count;
+            return task;
+        }
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        Deque tasks;
+        std::thread thread;
+    };
+
+    // Most tasks a thief takes at once
+    static constexpr size_t MAX_STOLEN = 32;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<size_t> queued {0};       // tasks in all deques
+    std::atomic<size_t> nextWorker {0};   // for tasks submitted from other threads
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<size_t> sleeping {0};
+    bool stop = false;
+
+    // Index of the calling thread in workers, or workers.size()
+    size_t getCurrentWorker() const;
+
+    void push(size_t worker, Task&& task);
+    bool pop(size_t worker, Task& task);
+    bool steal(size_t thief, Task& task);
+    void wake(size_t tasks);
+    void work(size_t worker);
+
+public:
+    explicit TaskScheduler(size_t threadCount = getDefaultThreadCount());
+    ~TaskScheduler(); // runs all queued tasks first
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    static size_t getDefaultThreadCount();
+
+    size_t getThreadCount() const {
+        return workers.size();
+    }
+
+    // Tasks submitted by a worker go to its own deque, others are spread over all deques
+    void submit(Task task);
+
+    // Submits f(0), ..., f(count - 1) with one lock per deque.
+    // Every task gets a copy of f, so f should capture by reference.
+    template<class F>
+    void submitBatch(size_t count, const F& f);
+
+    // Runs one queued task on the calling thread, returns false when there was none
+    bool runOne();
+};
+
+// Tasks whose completion is waited for together. The first exception
+// thrown by a task is rethrown by wait().
+class TaskGroup
+{
+private:
+    TaskScheduler& scheduler;
+    std::atomic<size_t> pending {0};
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+
+    void finish(std::exception_ptr taskError);
+
+public:
+    explicit TaskGroup(TaskScheduler& scheduler) : scheduler(scheduler) {}
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template<class F>
+    void run(F&& f) {
+        pending.fetch_add(1);
+        scheduler.submit([this, f = std::forward<F>(f)]() mutable {
+            std::exception_ptr taskError;
+            try {
+                f();
+            } catch (...) {
+                taskError = std::current_exception();
+            }
+            finish(taskError);
+        });
+    }
+
+    // Runs f(0), ..., f(count - 1), f has to live until wait() returned
+    template<class F>
+    void runBatch(size_t count, const F& f) {
+        pending.fetch_add(count);
+        scheduler.submitBatch(count, [this, &f](size_t i) {
+            std::exception_ptr taskError;
+            try {
+                f(i);
+            } catch (...) {
+                taskError = std::current_exception();
+            }
+            finish(taskError);
+        });
+    }
+
+    // A worker of the scheduler runs other tasks while it waits
+    void wait();
+};
+
+template<class F>
+void TaskScheduler::submitBatch(size_t count, const F& f)
+{
+    if (count == 0)
+        return;
+
+    // Contiguous ranges of indices per deque, the calling worker's first
+    size_t current = getCurrentWorker();
+    size_t first = current < workers.size() ? current : nextWorker.fetch_add(1) % workers.size();
+    size_t perWorker = (count + workers.size() - 1) / workers.size();
+
+    size_t begin = 0;
+    for (size_t w = 0; w < workers.size() && begin < count; ++w) {
+        size_t end = std::min(count, begin + perWorker);
+        Worker& worker = *workers[(first + w) % workers.size()];
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            // Pushed in reverse, so the owner pops them in index order
+            for (size_t i = end; i-- > begin;)
+                worker.tasks.pushBack(Task([f, i] { f(i); }));
+        }
+        queued.fetch_add(end - begin);
+        begin = end;
+    }
+    wake(count);
+}
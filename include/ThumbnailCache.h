@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "HashCache.h"
+
+// Resized thumbnails inlined into the channel pages (--thumbnail-as-base64),
+// stored in "<root>/.youtube-frontend/thumbnails/".
+//
+// An entry is addressed by the SHA-512 of the source image, the target size
+// and the format, so it is decoded and encoded only when the image changed.
+// The sums of the source images are kept like those of the video files, and
+// every entry is read from the disk at most once per run.
+class ThumbnailCache
+{
+public:
+    static inline const std::string DIRECTORY_NAME = "thumbnails";
+    static inline const std::string HASHES_FILE_NAME = "thumbnail-hashes.bin";
+
+    // Encoded image, empty when the source could not be read
+    using Image = std::shared_ptr<const std::vector<uint8_t>>;
+
+private:
+    std::filesystem::path directory;
+    HashCache sourceHashes;
+
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_future<Image>> images;
+    std::unordered_set<std::string> usedSources; // sum prefixes of this run
+
+    // Empty when the source cannot be read
+    std::string getSourcePrefix(const std::filesystem::path& source);
+
+    Image load(const std::string& key, const std::filesystem::path& source,
+               int width, int height, const std::string& format);
+
+public:
+    explicit ThumbnailCache(const std::filesystem::path& stateDirectory);
+
+    ThumbnailCache(const ThumbnailCache&) = delete;
+    ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+
+    // Thread-safe, concurrent requests of one image wait for a single resize
+    Image get(const std::filesystem::path& source, int width, int height, const std::string& format);
+
+    // Without a cache
+    static Image resize(const std::filesystem::path& source, int width, int height, const std::string& format);
+
+    // The source is used in this run, but its page was not rendered
+    void keep(const std::filesystem::path& source);
+
+    // Stores the sums of the source images.
+    // prune: the run used every source, entries and sums of all others are removed
+    void save(bool prune = false);
+};
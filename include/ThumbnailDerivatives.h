@@ -0,0 +1,96 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "ChannelIndex.h"
+#include "TaskScheduler.h"
+
+// Smaller thumbnails for the grids of the channel pages (--thumbnail-format,
+// --thumbnail-widths), written as "<root>/thumbnails/<snapshot>/thumbnail-<width>.<format>".
+// They stay out of the media directories of the snapshots, whose mtime
+// validates the records of the archive index.
+//
+// They are cropped to 16:9 like the grid cells, so their height follows from
+// the width without decoding them. A derivative is made again only when it is
+// missing or older than the downloaded thumbnail; all widths of a video are
+// made from one decoded image.
+class ThumbnailDerivatives
+{
+private:
+    std::filesystem::path archiveDirectory;
+    std::filesystem::path directory;
+    std::string format;
+    std::vector<int> widths;
+
+    // Snapshots with every derivative in place, filled by generate()
+    std::unordered_set<std::string> available;
+
+    // Returns false when the video has no usable thumbnail
+    bool generate(const YoutubeVideo& youtubeVideo, bool& converted) const;
+
+    // Derivatives of deleted snapshots and of other widths or formats
+    void removeUnreferenced() const;
+
+public:
+    static inline const std::string DIRECTORY_NAME = "thumbnails";
+
+    // widths sorted ascending, validated by Config
+    ThumbnailDerivatives(const std::filesystem::path& archiveBoxRootDirectory,
+                         std::string format,
+                         std::vector<int> widths);
+
+    static int getHeight(int width) {
+        return width * 9 / 16;
+    }
+
+    // e.g. "thumbnail-250.webp"
+    std::string getFileName(int width) const;
+
+    const std::string& getFormat() const {
+        return format;
+    }
+
+    const std::vector<int>& getWidths() const {
+        return widths;
+    }
+
+    // The narrowest derivative still as wide as the grid cell, else the widest
+    int getDefaultWidth(int cellWidth) const;
+
+    // Makes the missing and outdated derivatives of all videos on the workers
+    // and removes the unreferenced ones. Returns the number of converted thumbnails.
+    size_t generate(const ChannelIndex& channelIndex, TaskScheduler& scheduler,
+                    const std::filesystem::path& statusFile);
+
+    // Not thread-safe with generate(), safe for concurrent readers after it
+    bool isAvailable(const YoutubeVideo& youtubeVideo) const {
+        return available.contains(youtubeVideo.snapshot);
+    }
+};
@@ -25,11 +25,11 @@
 
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <iomanip>
 #include <filesystem>
-#include <openssl/sha.h>
 
 namespace fs = std::filesystem;
 
@@ -52,6 +52,12 @@ public:
     static void copyFile(const fs::path& src, const fs::path& dstDir);
     static void writeTextToFile(const std::string& text, const fs::path& file);
 
+    // Written next to the file and renamed, so readers and a failed write
+    // never see a partial file. Not synced to the disk: after a power loss
+    // the file may be empty, which the readers of these caches treat as damaged.
+    // Throws YoutubedlFrontendException on failure.
+    static void writeFileAtomically(std::string_view data, const fs::path& file);
+
     static std::string readTextFromFile(const fs::path& file);
 
     static std::string calculateSHA512Hash(const fs::path& file);
@@ -62,6 +68,15 @@ public:
                                             int width, int height,
                                             const std::string& format);
 
+    // Decodes the image once and encodes one copy per size, cropped to the
+    // aspect ratio of the size around the centre.
+    // Throws when the image could not be read or encoded.
+    static std::vector<std::vector<uint8_t>> cropAndResizeImage(const fs::path& input,
+                                                               const std::vector<std::pair<int, int>>& sizes,
+                                                               const std::string& format);
+
+    static bool canEncodeImage(const std::string& format);
+
     static void downloadFile(const std::string& url, const fs::path& target);
 
     static std::vector<std::string> split(const std::string&, char delimiter);
@@ -28,6 +28,7 @@
 #include <algorithm>
 #include <nlohmann/json.hpp>
 
+// A single comment as read from JSON, see YoutubeComments for the storage
 class YoutubeComment {
 public:
     std::string id;
@@ -41,14 +42,4 @@ public:
 
     nlohmann::json to_json();
     bool operator<(const YoutubeComment& other) const;
-
-    int dotCount() const;
-
-    static std::vector<YoutubeComment> sort(const std::vector<YoutubeComment>& list);
-
-private:
-    static std::vector<YoutubeComment> getChildren(
-        const std::vector<YoutubeComment>& all,
-        const std::string& parentId
-    );
 };
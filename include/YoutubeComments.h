@@ -0,0 +1,191 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "YoutubeComment.h"
+
+// The comments of one video, stored in an arena: all characters live in one
+// buffer and ids and authors are interned, so the parent id of a reply and
+// repeated authors are stored only once. A comment is a record of indices.
+// The data are immutable, copies of a YoutubeComments share them.
+class YoutubeComments
+{
+public:
+    static constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+    // A comment inside the arena, valid as long as the YoutubeComments exists.
+    // Depth, parent and reply count are set by getThreaded(), or restored
+    // by Builder::add(const Comment&).
+    struct Comment {
+        std::string_view id;
+        std::string_view parentId;
+        std::string_view text;
+        std::string_view author;
+        long timestamp;
+        uint32_t depth;      // 0 for top level comments
+        uint32_t parent;     // index of the parent comment, or NO_PARENT
+        uint32_t replyCount; // direct replies, they follow the comment
+    };
+
+private:
+    struct Record {
+        uint32_t id;
+        uint32_t parentId;
+        uint32_t text;
+        uint32_t author;
+        int64_t timestamp;
+        uint32_t depth;
+        uint32_t parent;
+        uint32_t replyCount;
+    };
+
+    struct Strings {
+        std::string buffer;
+        std::vector<uint32_t> ends; // string i is buffer[ends[i - 1], ends[i])
+
+        std::string_view get(uint32_t index) const {
+            uint32_t begin = index == 0 ? 0 : ends[index - 1];
+            return std::string_view(buffer).substr(begin, ends[index] - begin);
+        }
+    };
+
+    struct Data {
+        std::shared_ptr<const Strings> strings;
+        std::vector<Record> records;
+        uint64_t digest;
+    };
+
+    std::shared_ptr<const Data> data;
+
+    explicit YoutubeComments(std::shared_ptr<const Data> data);
+
+    static uint64_t computeDigest(const Strings& strings, const std::vector<Record>& records);
+
+public:
+    class Builder
+    {
+        std::shared_ptr<Strings> strings;
+        std::vector<Record> records;
+        std::vector<uint32_t> table; // open addressing, interned string index + 1, 0 = empty
+        size_t internedCount = 0;
+
+        uint32_t append(std::string_view value);
+        uint32_t intern(std::string_view value);
+
+    public:
+        Builder();
+
+        void add(std::string_view id, std::string_view parentId, std::string_view text,
+                 std::string_view author, long timestamp);
+        void add(const YoutubeComment& comment);
+
+        // A comment of a list in threaded order, with its depth, parent and reply count
+        void add(const Comment& comment);
+
+        size_t size() const {
+            return records.size();
+        }
+
+        // The comments in the order of add(), the builder is empty afterwards
+        YoutubeComments build();
+    };
+
+    class Iterator
+    {
+        const YoutubeComments* comments = nullptr;
+        size_t index = 0;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Comment;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Comment;
+
+        Iterator() = default;
+        Iterator(const YoutubeComments* comments, size_t index) : comments(comments), index(index) {}
+
+        Comment operator*() const {
+            return (*comments)[index];
+        }
+
+        Iterator& operator++() {
+            ++index;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++index;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return index == other.index;
+        }
+    };
+
+    YoutubeComments() = default;
+
+    size_t size() const {
+        return data ? data->records.size() : 0;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    Comment operator[](size_t index) const;
+
+    Iterator begin() const {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() const {
+        return Iterator(this, size());
+    }
+
+    // Threaded order: every comment is followed by its replies, siblings
+    // are ordered by timestamp. Comments not connected to "root" are dropped.
+    // Computes depth, parent and reply count of every comment.
+    // Linear in the number of comments, the strings are shared with this list.
+    YoutubeComments getThreaded() const;
+
+    // Hash of the comments in this order, with their depth, parent and reply
+    // count. Computed once when the list is built, so pages can compare it cheaply.
+    uint64_t getDigest() const {
+        return data ? data->digest : 0;
+    }
+
+    // Bytes allocated for the comments
+    size_t getMemoryUsage() const;
+};
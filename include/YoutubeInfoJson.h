@@ -0,0 +1,66 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "YoutubeComments.h"
+
+struct YoutubeInfoJsonThumbnail {
+    std::string url;
+    int width = -1; // -1 = no width in the JSON
+};
+
+// The subset of a yt-dlp ".info.json" file used by youtube-frontend.
+// The file is scanned with the nlohmann SAX interface, so large subtrees
+// like "formats" are skipped without building a DOM for them.
+class YoutubeInfoJson {
+public:
+    std::string id;
+    std::string title;
+    std::string channel;
+    std::string channelUrl;
+    std::string channelId;
+    std::string thumbnail;
+    std::vector<YoutubeInfoJsonThumbnail> thumbnails;
+    std::string ext;
+    std::string uploadDate;
+    long timestamp = 0;
+    YoutubeComments comments; // in the order of the file
+
+    static YoutubeInfoJson parse(std::string_view json);
+
+    // Parses the file from a read-only memory mapping
+    static YoutubeInfoJson load(const std::filesystem::path& file);
+
+    // Reads only the top level "id" and "channel_id", the scan stops as soon
+    // as both are found ("id" alone when !needChannelId). yt-dlp writes them
+    // before the comments, which make up most of a large file.
+    // Returns false when the file cannot be parsed.
+    static bool scanIds(std::string_view json, bool needChannelId, std::string& id, std::string& channelId);
+    static bool loadIds(const std::filesystem::path& file, bool needChannelId, std::string& id, std::string& channelId);
+};
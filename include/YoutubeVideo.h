@@ -30,9 +30,11 @@
 #include <cstdint>
 #include <map>
 
-#include "Args.h"
-#include "ArgType.h"
-#include "YoutubeComment.h"
+#include "Config.h"
+#include "YoutubeComments.h"
+
+class HashCache;
+class TaskScheduler;
 
 class YoutubeVideo
 {
@@ -52,24 +54,36 @@ public:
     std::string description;
     std::string thumbnail;
     std::string miniThumbnail;
-    std::vector<YoutubeComment> comments;
+    YoutubeComments comments;
     std::string previousVideoId;
     std::string nextVideoId;
     std::string ext;
     int number;
 
+    // Set when the info JSON was parsed, but the video file was not read yet
+    bool videoFileAnalysisPending = false;
+
+    // Set when the info JSON was parsed and the snapshot has no video file,
+    // loadYoutubeVideos() collects these into missingYoutubeVideos
+    bool videoFileMissing = false;
+
     static std::vector<std::string> missingYoutubeVideos;
     static long totalDurationInMilliseconds;
 
 public:
     YoutubeVideo();
 
+    // Reads the metadata file, or parses the info JSON.
+    // The video file itself is read by analyzeVideoFile().
     YoutubeVideo(
         const std::filesystem::path& mediaDirectory,
-        bool alwaysGenerateMetadata,
-        const std::string& argVideo
+        bool alwaysGenerateMetadata
     );
 
+    // Hashes and probes the video file and writes the metadata file.
+    // Returns the number of bytes read from the video file.
+    uint64_t analyzeVideoFile(const std::filesystem::path& mediaDirectory, HashCache& hashCache);
+
     long getVideoDurationInMilliseconds() const;
     long getVideoDurationInMinutes() const;
     long getVideoFileSizeInMegaBytes() const;
@@ -82,7 +96,8 @@ public:
     // load static
     static std::vector<YoutubeVideo> loadYoutubeVideos(
         const std::filesystem::path& archiveBoxArchiveDirectory,
-        const Args& argsInstance
+        const Config& config,
+        TaskScheduler& scheduler
     );
 
 private:
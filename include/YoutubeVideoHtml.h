@@ -24,22 +24,43 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <filesystem>
+#include "HtmlBuffer.h"
 #include "YoutubeVideo.h"
 
+// Videos with huge comment sections embed only the first top level threads.
+// The rest is written to "videos/<id>/comments-<k>.html", k = 1, 2, ...,
+// every shard ends with a link which loads the next one into the page.
+struct CommentPaging {
+    size_t threadsPerPage = 0; // 0 = all comments on the video page
+    size_t maxShards = 100;    // shards get bigger when there are more threads
+};
+
 class YoutubeVideoHtml {
 private:
-    std::string singleVideo;
+    HtmlBuffer::Pooled page;
+    std::vector<HtmlBuffer::Pooled> commentShards;
 
 public:
     YoutubeVideoHtml(
         const YoutubeVideo& youtubeVideo,
         const std::filesystem::path& archiveBoxRootDirectory,
         const std::filesystem::path& archiveBoxArchiveDirectory,
-        long countOfVideosInChannel
+        long countOfVideosInChannel,
+        const CommentPaging& commentPaging = {}
     );
 
+    const HtmlBuffer& getPage() const {
+        return *page;
+    }
+
     std::string toString() const {
-        return singleVideo;
+        return page->toString();
+    }
+
+    // Content of comments-1.html, comments-2.html, ...
+    const std::vector<HtmlBuffer::Pooled>& getCommentShards() const {
+        return commentShards;
     }
 };
@@ -0,0 +1,138 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ArchiveIndex.h"
+#include "BinaryIo.h"
+#include "MetadataCache.h"
+#include "Utils.h"
+#include "YoutubedlFrontendException.h"
+
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+
+namespace fs = std::filesystem;
+
+ArchiveIndex::ArchiveIndex(const fs::path& file)
+    : file(file)
+{
+    if (!fs::exists(file))
+        return;
+
+    mappedFile = std::make_unique<MappedFile>(file);
+    BinaryReader reader(mappedFile->view());
+
+    try
+    {
+        if (reader.readUInt32() != MAGIC || reader.readUInt32() != VERSION)
+        {
+            damaged = true;
+            return;
+        }
+
+        while (!reader.atEnd())
+        {
+            std::string snapshot(reader.readString());
+            int64_t mtime = reader.readInt64();
+            std::string_view record = reader.readString();
+            entries[snapshot] = Entry{mtime, record};
+            ++recordCount;
+        }
+    }
+    catch (const YoutubedlFrontendException&)
+    {
+        // Interrupted append, the complete records before it are still fine
+        std::cerr << "[Warning] Damaged end of " << file.string() << ", it will be rewritten\n";
+        damaged = true;
+    }
+}
+
+std::optional<std::string_view> ArchiveIndex::find(const std::string& snapshot, int64_t mediaDirectoryMtime)
+{
+    auto it = entries.find(snapshot);
+    if (it == entries.end() || it->second.mediaDirectoryMtime != mediaDirectoryMtime)
+        return std::nullopt;
+
+    usedSnapshots.insert(snapshot);
+    return it->second.record;
+}
+
+void ArchiveIndex::add(const std::string& snapshot, int64_t mediaDirectoryMtime, const YoutubeVideo& video)
+{
+    pendingSnapshots.insert(snapshot);
+    usedSnapshots.insert(snapshot);
+
+    BinaryWriter writer(pending);
+    writer.writeString(snapshot);
+    writer.writeInt64(mediaDirectoryMtime);
+    writer.writeString(MetadataCache::serialize(video));
+}
+
+void ArchiveIndex::save()
+{
+    if (pending.empty() && !damaged && usedSnapshots.size() == entries.size())
+        return;
+
+    fs::create_directories(file.parent_path());
+
+    size_t liveCount = usedSnapshots.size();
+    size_t totalCount = recordCount + pendingSnapshots.size();
+    bool append = mappedFile && !damaged && totalCount <= 2 * liveCount;
+
+    if (append)
+    {
+        std::ofstream ofs(file, std::ios::binary | std::ios::app);
+        if (!ofs)
+            throw YoutubedlFrontendException("Cannot write archive index: " + file.string());
+        ofs << pending;
+        ofs.flush();
+        // A torn record is dropped by the next load, but this run must not pass as saved
+        if (!ofs)
+            throw YoutubedlFrontendException("Cannot append to archive index: " + file.string());
+        return;
+    }
+
+    // Compaction: keep the latest record of every snapshot seen in this run
+    std::string out;
+    BinaryWriter writer(out);
+    writer.writeUInt32(MAGIC);
+    writer.writeUInt32(VERSION);
+
+    for (const auto& snapshot : usedSnapshots)
+    {
+        if (pendingSnapshots.contains(snapshot))
+            continue;
+        const Entry& entry = entries.at(snapshot);
+        writer.writeString(snapshot);
+        writer.writeInt64(entry.mediaDirectoryMtime);
+        writer.writeString(entry.record);
+    }
+    out += pending;
+
+    Utils::writeFileAtomically(out, file);
+}
+
+int64_t ArchiveIndex::getMtime(const struct stat& st)
+{
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000L + st.st_mtim.tv_nsec;
+}
@@ -26,13 +26,9 @@
 const std::vector<ArgType>& get_arg_type_values()
 {
     static std::vector<ArgType> v{
-        ArgType::VIDEO,
-        ArgType::CHANNEL,
-        ArgType::VIDEOS_PER_ROW,
-        ArgType::ALWAYS_GENERATE_METADATA,
-        ArgType::ALWAYS_GENERATE_HTML_FILES,
-        ArgType::THUMBNAIL_AS_BASE64,
-        ArgType::THUMBNAIL_LINKS_TO_YOUTUBE
+#define YOUTUBE_FRONTEND_ARG_TYPE(TYPE, NAME, CPP_TYPE, DEFAULT_VALUE, FIELD) ArgType::TYPE,
+        YOUTUBE_FRONTEND_ARGS(YOUTUBE_FRONTEND_ARG_TYPE)
+#undef YOUTUBE_FRONTEND_ARG_TYPE
     };
     return v;
 }
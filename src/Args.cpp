@@ -34,7 +34,7 @@ Args::Args(const std::vector<std::string>& args)
 
         if (i == 0 && arg.rfind(TWO_DASHES, 0) != 0)
         {
-            continue; // first must be --..., otherwise skip
+            continue; // the working directory
         }
 
         // find match by name
@@ -49,28 +49,28 @@ Args::Args(const std::vector<std::string>& args)
             }
         }
 
-        if (found.has_value())
+        if (!found.has_value())
         {
-            ++i;
-            if (i >= args.size())
-            {
-                throw YoutubedlFrontendException(
-                    std::string("Fatal error: missing value for --") + get_name(found.value())
-                );
-            }
-
-            std::string value = args[i];
+            throw YoutubedlFrontendException(
+                arg.rfind(TWO_DASHES, 0) == 0
+                    ? "Fatal error: unknown option " + arg
+                    : "Fatal error: unexpected argument " + arg
+            );
+        }
 
-            if (found.value() == ArgType::VIDEOS_PER_ROW)
-            {
-                int intVal = std::atoi(args[i].c_str());
-                if (intVal < 2)
-                {
-                    value = "0";
-                }
-            }
+        ++i;
+        if (i >= args.size())
+        {
+            throw YoutubedlFrontendException(
+                std::string("Fatal error: missing value for --") + get_name(found.value())
+            );
+        }
 
-            map.emplace(found.value(), Arg(found.value(), value));
+        if (!map.emplace(found.value(), Arg(found.value(), args[i])).second)
+        {
+            throw YoutubedlFrontendException(
+                std::string("Fatal error: --") + get_name(found.value()) + " given twice"
+            );
         }
     }
 }
@@ -90,20 +90,6 @@ std::optional<std::string> Args::getString(ArgType type) const
     return it->second.value;
 }
 
-bool Args::getBool(ArgType type) const
-{
-    auto o = getString(type);
-    if (!o.has_value()) return false;
-    return Utils::convertStringToBoolean(o.value());
-}
-
-std::optional<int> Args::getInt(ArgType type) const
-{
-    auto o = getString(type);
-    if (!o.has_value()) return std::nullopt;
-    return std::stoi(o.value());
-}
-
 std::string Args::to_string() const
 {
     std::ostringstream ss;
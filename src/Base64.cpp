@@ -0,0 +1,221 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Base64.h"
+
+#include <algorithm>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Encodes all of [begin, end) with padding, returns the end of the text
+using Encode = char* (*)(char* out, const uint8_t* begin, const uint8_t* end);
+
+static constexpr char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Input bytes encoded per append when the page buffer has no room for all of them
+static constexpr size_t BLOCK_SIZE = 3 * 1024;
+
+static char* encodeScalar(char* out, const uint8_t* begin, const uint8_t* end)
+{
+    for (; end - begin >= 3; begin += 3)
+    {
+        uint32_t bits = (uint32_t(begin[0]) << 16) | (uint32_t(begin[1]) << 8) | begin[2];
+        *out++ = ALPHABET[bits >> 18];
+        *out++ = ALPHABET[(bits >> 12) & 63];
+        *out++ = ALPHABET[(bits >> 6) & 63];
+        *out++ = ALPHABET[bits & 63];
+    }
+
+    if (end - begin == 1)
+    {
+        uint32_t bits = uint32_t(begin[0]) << 16;
+        *out++ = ALPHABET[bits >> 18];
+        *out++ = ALPHABET[(bits >> 12) & 63];
+        *out++ = '=';
+        *out++ = '=';
+    }
+    else if (end - begin == 2)
+    {
+        uint32_t bits = (uint32_t(begin[0]) << 16) | (uint32_t(begin[1]) << 8);
+        *out++ = ALPHABET[bits >> 18];
+        *out++ = ALPHABET[(bits >> 12) & 63];
+        *out++ = ALPHABET[(bits >> 6) & 63];
+        *out++ = '=';
+    }
+    return out;
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define BASE64_SIMD 1
+
+// 12 bytes in every 16 byte lane -> 16 indices of 6 bits
+__attribute__((target("ssse3")))
+static __m128i splitSsse3(__m128i in)
+{
+    // Bytes b1 b0 b2 b1 of every 3-byte group, so each 32-bit word holds
+    // the four 6-bit fields at the positions the multiplications expect
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    __m128i high = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    __m128i low = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(high, low);
+}
+
+// Index 0..63 -> character, by adding the offset of its range of the alphabet
+__attribute__((target("ssse3")))
+static __m128i translateSsse3(__m128i indices)
+{
+    // Offsets for A-Z, a-z, 0-9 (10 ranges of one index each), '+' and '/'
+    const __m128i offsets = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    range = _mm_sub_epi8(range, _mm_cmpgt_epi8(indices, _mm_set1_epi8(25)));
+    return _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, range));
+}
+
+__attribute__((target("ssse3")))
+static char* encodeSsse3(char* out, const uint8_t* begin, const uint8_t* end)
+{
+    // 16 bytes are loaded, 12 of them used
+    for (; end - begin >= 16; begin += 12, out += 16)
+    {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), translateSsse3(splitSsse3(in)));
+    }
+    return encodeScalar(out, begin, end);
+}
+
+__attribute__((target("avx2")))
+static __m256i splitAvx2(__m256i in)
+{
+    in = _mm256_shuffle_epi8(in, _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                                  1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    __m256i high = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+    __m256i low = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+    return _mm256_or_si256(high, low);
+}
+
+__attribute__((target("avx2")))
+static __m256i translateAvx2(__m256i indices)
+{
+    const __m256i offsets = _mm256_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+                                             65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+    __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    range = _mm256_sub_epi8(range, _mm256_cmpgt_epi8(indices, _mm256_set1_epi8(25)));
+    return _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, range));
+}
+
+__attribute__((target("avx2")))
+static char* encodeAvx2(char* out, const uint8_t* begin, const uint8_t* end)
+{
+    // Every lane takes 12 of the 16 bytes loaded for it, 28 bytes are read
+    for (; end - begin >= 28; begin += 24, out += 32)
+    {
+        __m256i in = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(begin))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + 12)), 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), translateAvx2(splitAvx2(in)));
+    }
+    return encodeSsse3(out, begin, end);
+}
+#endif
+
+bool Base64::isSupported(Implementation implementation)
+{
+    switch (implementation)
+    {
+    case Implementation::SCALAR:
+        return true;
+#if defined(BASE64_SIMD)
+    case Implementation::SSSE3:
+        return __builtin_cpu_supports("ssse3");
+    case Implementation::AVX2:
+        return __builtin_cpu_supports("avx2");
+#else
+    default:
+        return false;
+#endif
+    }
+    return false;
+}
+
+Base64::Implementation Base64::getBest()
+{
+    static const Implementation best =
+        isSupported(Implementation::AVX2) ? Implementation::AVX2
+        : isSupported(Implementation::SSSE3) ? Implementation::SSSE3
+        : Implementation::SCALAR;
+    return best;
+}
+
+static Encode getEncode(Base64::Implementation implementation)
+{
+    switch (implementation)
+    {
+#if defined(BASE64_SIMD)
+    case Base64::Implementation::AVX2:
+        return encodeAvx2;
+    case Base64::Implementation::SSSE3:
+        return encodeSsse3;
+#endif
+    default:
+        return encodeScalar;
+    }
+}
+
+static void appendEncoded(HtmlBuffer& out, std::span<const uint8_t> data, Encode encode)
+{
+    const uint8_t* begin = data.data();
+    const uint8_t* end = begin + data.size();
+
+    // A thumbnail usually fits into the current chunk
+    if (char* space = out.getFreeSpace(Base64::getEncodedSize(data.size())))
+    {
+        out.commit(encode(space, begin, end) - space);
+        return;
+    }
+
+    // Blocks of a multiple of 3 bytes, so only the last one is padded
+    char text[Base64::getEncodedSize(BLOCK_SIZE)];
+    while (begin != end)
+    {
+        const uint8_t* blockEnd = begin + std::min<size_t>(BLOCK_SIZE, end - begin);
+        if (char* space = out.getFreeSpace(Base64::getEncodedSize(blockEnd - begin)))
+            out.commit(encode(space, begin, blockEnd) - space);
+        else
+            out.append(std::string_view(text, encode(text, begin, blockEnd) - text));
+        begin = blockEnd;
+    }
+}
+
+void Base64::append(HtmlBuffer& out, std::span<const uint8_t> data)
+{
+    static const Encode encode = getEncode(getBest());
+    appendEncoded(out, data, encode);
+}
+
+void Base64::append(HtmlBuffer& out, std::span<const uint8_t> data, Implementation implementation)
+{
+    appendEncoded(out, data, getEncode(isSupported(implementation) ? implementation : Implementation::SCALAR));
+}
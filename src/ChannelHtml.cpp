@@ -0,0 +1,187 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ChannelHtml.h"
+#include "Base64.h"
+#include "Constants.h"
+#include "HtmlEscape.h"
+#include "PageTemplates.h"
+
+#include <algorithm>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Size of the thumbnails inlined with --thumbnail-as-base64
+static constexpr int INLINE_THUMBNAIL_WIDTH = 25;
+static constexpr int INLINE_THUMBNAIL_HEIGHT = static_cast<int>(9.0 / 16.0 * 25.0);
+
+// The src of a thumbnail in the video grid: a relative path, or the
+// resized image inlined as a data URI, encoded straight into the page
+struct ThumbnailSource {
+    std::string path;
+    ThumbnailCache::Image image;
+
+    void appendTo(HtmlBuffer& out) const {
+        if (!image) {
+            HtmlEscape::append(out, path);
+            return;
+        }
+        out << "data:image/jpg;base64,";
+        Base64::append(out, *image);
+    }
+};
+
+// The srcset of the converted thumbnails of one video
+struct ThumbnailSrcset {
+    const ThumbnailDerivatives& derivatives;
+    std::string_view directory;
+
+    void appendTo(HtmlBuffer& out) const {
+        const char* separator = "";
+        for (int width : derivatives.getWidths()) {
+            out << separator;
+            HtmlEscape::append(out, directory);
+            HtmlEscape::append(out, derivatives.getFileName(width));
+            out << ' ' << width << 'w';
+            separator = ", ";
+        }
+    }
+};
+
+ChannelHtml::ChannelHtml(
+    const ChannelIndex& channelIndex,
+    const ChannelIndexEntry* wantedChannel,
+    const Config& config,
+    const fs::path& archiveBoxRootDirectory,
+    ThumbnailCache* thumbnailCache,
+    const ThumbnailDerivatives* thumbnailDerivatives
+) : page(HtmlBuffer::acquire()) {
+    using namespace PageTemplates;
+    HtmlBuffer& out = *page;
+
+    const int vpr = config.videosPerRow;
+    const bool thumbnailLinksToYoutube = config.thumbnailLinksToYoutube;
+    const bool thumbnailAsBase64 = config.thumbnailAsBase64;
+
+    ChannelPageHead::render(out);
+
+    // The master list renders every channel header, a channel page only its own
+    std::span<const ChannelIndexEntry> channels = wantedChannel
+        ? std::span<const ChannelIndexEntry>(wantedChannel, 1)
+        : std::span<const ChannelIndexEntry>(channelIndex.getChannels());
+
+    for (const auto& channel : channels) {
+        ChannelBegin::render(out,
+            html::arg<"name">(channel.name),
+            html::arg<"maxWidth">((THUMBNAIL_WIDTH + 20) * vpr),
+            html::arg<"id">(channel.id),
+            html::arg<"url">(channel.url));
+
+        if (wantedChannel) {
+            VideoGridBegin::render(out);
+
+            int videoNumberInRow = 0;
+
+            for (const auto& youtubeVideo : channelIndex.getVideos(channel)) {
+                if (videoNumberInRow == 0)
+                    VideoGridRow::render(out);
+
+                ++videoNumberInRow;
+
+                // Thumbnail source
+                std::string thumbnailPath =
+                    "archive/" + youtubeVideo.snapshot
+                    + "/media/mini-thumbnail."
+                    + youtubeVideo.getMiniThumbnailFormat();
+
+                ThumbnailSource thumbnail;
+                if (thumbnailAsBase64) {
+                    fs::path filePath = archiveBoxRootDirectory / thumbnailPath;
+                    std::string format = youtubeVideo.getThumbnailFormat();
+                    thumbnail.image = thumbnailCache
+                        ? thumbnailCache->get(filePath, INLINE_THUMBNAIL_WIDTH, INLINE_THUMBNAIL_HEIGHT, format)
+                        : ThumbnailCache::resize(filePath, INLINE_THUMBNAIL_WIDTH, INLINE_THUMBNAIL_HEIGHT, format);
+                } else {
+                    thumbnail.path = "../" + thumbnailPath;
+                }
+
+                // Upload date formatted yyyy-mm-dd
+                std::string_view uploadDate = youtubeVideo.uploadDate;
+                char formattedDate[10];
+                if (uploadDate.size() >= 8) {
+                    char* p = std::copy_n(uploadDate.data(), 4, formattedDate);
+                    *p++ = '-';
+                    p = std::copy_n(uploadDate.data() + 4, 2, p);
+                    *p++ = '-';
+                    std::copy_n(uploadDate.data() + 6, 2, p);
+                    uploadDate = std::string_view(formattedDate, sizeof(formattedDate));
+                }
+
+                VideoGridCellBegin::render(out,
+                    html::arg<"thumbnailWidth">(THUMBNAIL_WIDTH),
+                    // Thumbnail link target
+                    html::arg<"linkPrefix">(thumbnailLinksToYoutube ? "https://www.youtube.com/watch?v=" : "../videos/"),
+                    html::arg<"id">(youtubeVideo.id),
+                    html::arg<"linkSuffix">(thumbnailLinksToYoutube ? "" : ".html"));
+
+                if (thumbnailDerivatives && thumbnailDerivatives->isAvailable(youtubeVideo)) {
+                    std::string directory = "../" + ThumbnailDerivatives::DIRECTORY_NAME + "/" + youtubeVideo.snapshot + "/";
+                    VideoGridThumbnailSet::render(out,
+                        html::arg<"thumbnail">(directory + thumbnailDerivatives->getFileName(
+                            thumbnailDerivatives->getDefaultWidth(THUMBNAIL_WIDTH))),
+                        html::arg<"srcset">(ThumbnailSrcset{*thumbnailDerivatives, directory}),
+                        html::arg<"thumbnailWidth">(THUMBNAIL_WIDTH),
+                        html::arg<"thumbnailHeight">(ThumbnailDerivatives::getHeight(THUMBNAIL_WIDTH)));
+                } else {
+                    VideoGridThumbnail::render(out,
+                        html::arg<"thumbnail">(thumbnail),
+                        html::arg<"thumbnailWidth">(THUMBNAIL_WIDTH));
+                }
+
+                VideoGridCellEnd::render(out,
+                    html::arg<"title">(youtubeVideo.title),
+                    html::arg<"uploadDate">(uploadDate),
+                    html::arg<"duration">(youtubeVideo.videoDuration),
+                    html::arg<"number">(youtubeVideo.number));
+
+                if (videoNumberInRow == vpr) {
+                    VideoGridRow::render(out);
+                    videoNumberInRow = 0;
+                }
+            }
+
+            if (videoNumberInRow < vpr) {
+                VideoGridRow::render(out);
+            }
+
+            VideoGridEnd::render(out);
+        }
+
+        ChannelEnd::render(out); // wrapper with max-width
+    }
+
+    ChannelPageEnd::render(out);
+}
@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ChannelIndex.h"
+#include "YoutubedlFrontendException.h"
+
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
+
+static std::string getChannelIdFromUrl(const std::string& url, const std::string& channelName)
+{
+    const std::string needle = "/channel/";
+    auto pos = url.find(needle);
+    return (pos == std::string::npos)
+           ? channelName
+           : url.substr(pos + needle.size());
+}
+
+ChannelIndex::ChannelIndex(std::vector<YoutubeVideo>& videos)
+    : videos(videos)
+{
+    std::unordered_set<std::string> seen;
+
+    size_t i = 0;
+    while (i < videos.size())
+    {
+        const std::string& channelName = videos[i].channelName;
+        if (channelName.empty())
+        {
+            ++i;
+            continue;
+        }
+
+        if (!seen.insert(channelName).second)
+            throw YoutubedlFrontendException("Videos of channel are not sorted together: " + channelName);
+
+        size_t end = i;
+        while (end < videos.size() && videos[end].channelName == channelName)
+        {
+            // Position of the video inside its channel, shown as "#n" on the pages
+            videos[end].number = static_cast<int>(end - i + 1);
+            ++end;
+        }
+
+        ChannelIndexEntry entry;
+        entry.name = channelName;
+        entry.url = videos[i].channelUrl;
+        entry.id = getChannelIdFromUrl(entry.url, channelName);
+        entry.firstVideo = i;
+        entry.videoCount = end - i;
+        entry.firstVideoId = videos[i].id;
+        entry.lastVideoId = videos[end - 1].id;
+        channels.push_back(std::move(entry));
+
+        i = end;
+    }
+
+    std::sort(channels.begin(), channels.end(),
+              [](const ChannelIndexEntry& a, const ChannelIndexEntry& b) {
+                  std::string A = a.name, B = b.name;
+                  std::transform(A.begin(), A.end(), A.begin(), ::tolower);
+                  std::transform(B.begin(), B.end(), B.begin(), ::tolower);
+                  return A < B;
+              });
+}
@@ -0,0 +1,104 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Config.h"
+#include "Args.h"
+#include "Utils.h"
+#include "YoutubedlFrontendException.h"
+
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+static YoutubedlFrontendException invalidValue(ArgType type, const std::string& text, const std::string& expected)
+{
+    return YoutubedlFrontendException(std::string("Invalid value for ") + Args::TWO_DASHES + get_name(type)
+                                      + ": \"" + text + "\", expected " + expected);
+}
+
+static void parseValue(ArgType, const std::string& text, std::string& value)
+{
+    value = text;
+}
+
+static void parseValue(ArgType type, const std::string& text, bool& value)
+{
+    try {
+        value = Utils::convertStringToBoolean(text);
+    } catch (const std::runtime_error&) {
+        throw invalidValue(type, text, "true, false, 1 or 0");
+    }
+}
+
+static void parseValue(ArgType type, const std::string& text, int& value)
+{
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    if (ec != std::errc() || ptr != end || text.empty())
+        throw invalidValue(type, text, "an integer");
+}
+
+static void parseValue(ArgType type, const std::string& text, std::vector<int>& value)
+{
+    value.clear();
+    for (const std::string& item : Utils::split(text, ',')) {
+        int number = 0;
+        const char* end = item.data() + item.size();
+        auto [ptr, ec] = std::from_chars(item.data(), end, number);
+        if (ec != std::errc() || ptr != end || item.empty())
+            throw invalidValue(type, text, "comma separated integers");
+        value.push_back(number);
+    }
+}
+
+Config::Config(const Args& args)
+{
+#define YOUTUBE_FRONTEND_CONFIG_PARSE(TYPE, NAME, CPP_TYPE, DEFAULT_VALUE, FIELD) \
+    parseValue(ArgType::TYPE, args.getString(ArgType::TYPE).value_or(""), FIELD);
+    YOUTUBE_FRONTEND_ARGS(YOUTUBE_FRONTEND_CONFIG_PARSE)
+#undef YOUTUBE_FRONTEND_CONFIG_PARSE
+
+    // Less than 2 videos per row: no row breaks, every video in one row
+    if (videosPerRow < 2)
+        videosPerRow = 0;
+    if (ioConcurrency < 1)
+        throw invalidValue(ArgType::IO_CONCURRENCY, std::to_string(ioConcurrency), "at least 1");
+    if (commentThreadsPerPage < 0)
+        throw invalidValue(ArgType::COMMENT_THREADS_PER_PAGE, std::to_string(commentThreadsPerPage), "at least 0");
+    if (maxCommentShards < 1)
+        throw invalidValue(ArgType::MAX_COMMENT_SHARDS, std::to_string(maxCommentShards), "at least 1");
+
+    if (!thumbnailFormat.empty()) {
+        if (!Utils::canEncodeImage(thumbnailFormat))
+            throw invalidValue(ArgType::THUMBNAIL_FORMAT, thumbnailFormat, "an image format OpenCV can write, e.g. webp");
+        if (thumbnailAsBase64)
+            throw YoutubedlFrontendException(std::string(Args::TWO_DASHES) + get_name(ArgType::THUMBNAIL_FORMAT)
+                                             + " cannot be combined with " + Args::TWO_DASHES
+                                             + get_name(ArgType::THUMBNAIL_AS_BASE64));
+    }
+    std::sort(thumbnailWidths.begin(), thumbnailWidths.end());
+    thumbnailWidths.erase(std::unique(thumbnailWidths.begin(), thumbnailWidths.end()), thumbnailWidths.end());
+    if (thumbnailWidths.empty() || thumbnailWidths.front() < 16 || thumbnailWidths.back() > 4096)
+        throw invalidValue(ArgType::THUMBNAIL_WIDTHS, args.getString(ArgType::THUMBNAIL_WIDTHS).value_or(""),
+                           "widths from 16 to 4096");
+}
@@ -0,0 +1,226 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "FileHasher.h"
+#include "YoutubedlFrontendException.h"
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <openssl/evp.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr size_t BUFFER_ALIGNMENT = 4096;
+
+struct FreeDeleter {
+    void operator()(char* p) const { std::free(p); }
+};
+
+using AlignedBuffer = std::unique_ptr<char, FreeDeleter>;
+
+AlignedBuffer allocateAlignedBuffer(size_t size)
+{
+    size = (size + BUFFER_ALIGNMENT - 1) / BUFFER_ALIGNMENT * BUFFER_ALIGNMENT;
+    auto* p = static_cast<char*>(std::aligned_alloc(BUFFER_ALIGNMENT, size));
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return AlignedBuffer(p);
+}
+
+// Fills the buffer unless the end of the file comes first, returns the count of read bytes
+ssize_t readFully(int fd, char* buffer, size_t size)
+{
+    size_t total = 0;
+    while (total < size)
+    {
+        ssize_t n = ::read(fd, buffer + total, size - total);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        if (n == 0)
+            break;
+        total += static_cast<size_t>(n);
+    }
+    return static_cast<ssize_t>(total);
+}
+
+struct EvpContextDeleter {
+    void operator()(EVP_MD_CTX* ctx) const { EVP_MD_CTX_free(ctx); }
+};
+
+class FileDescriptor {
+public:
+    int fd;
+    explicit FileDescriptor(int fd) : fd(fd) {}
+    ~FileDescriptor() { if (fd >= 0) ::close(fd); }
+};
+
+// One chunk handed over from the reading thread to the hashing thread
+struct Chunk {
+    AlignedBuffer buffer;
+    ssize_t size = 0;
+    bool full = false;
+};
+
+} // namespace
+
+FileHasher::FileHasher(const std::string& digestName, size_t bufferSize)
+    : digest(EVP_get_digestbyname(digestName.c_str())),
+      bufferSize(bufferSize)
+{
+    if (digest == nullptr)
+        throw YoutubedlFrontendException("Unknown digest: " + digestName);
+}
+
+std::string FileHasher::hashFile(const fs::path& file) const
+{
+    FileDescriptor descriptor(::open(file.c_str(), O_RDONLY | O_CLOEXEC));
+    int fd = descriptor.fd;
+    if (fd < 0)
+        throw YoutubedlFrontendException("Cannot open file: " + file.string());
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0)
+        throw YoutubedlFrontendException("Cannot stat file: " + file.string());
+    const auto fileSize = static_cast<size_t>(st.st_size);
+
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    std::unique_ptr<EVP_MD_CTX, EvpContextDeleter> ctx(EVP_MD_CTX_new());
+    if (!ctx || EVP_DigestInit_ex(ctx.get(), digest, nullptr) != 1)
+        throw YoutubedlFrontendException("Cannot initialize digest");
+
+    bool readError = false;
+
+    if (fileSize < bufferSize)
+    {
+        // One chunk only, a reading thread would not pay off
+        AlignedBuffer buffer = allocateAlignedBuffer(fileSize + 1);
+        ssize_t n = readFully(fd, buffer.get(), fileSize + 1);
+        readError = n < 0;
+        if (!readError)
+            EVP_DigestUpdate(ctx.get(), buffer.get(), static_cast<size_t>(n));
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    }
+    else
+    {
+        Chunk chunks[2];
+        for (auto& chunk : chunks)
+            chunk.buffer = allocateAlignedBuffer(bufferSize);
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool stop = false;
+
+        std::thread reader([&] {
+            off_t offset = 0;
+            for (int i = 0;; i ^= 1)
+            {
+                Chunk& chunk = chunks[i];
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    condition.wait(lock, [&] { return !chunk.full || stop; });
+                    if (stop)
+                        return;
+                }
+
+                ssize_t n = readFully(fd, chunk.buffer.get(), bufferSize);
+                if (n > 0)
+                {
+                    // The data is in our buffer now, keep the page cache for others
+                    ::posix_fadvise(fd, offset, n, POSIX_FADV_DONTNEED);
+                    offset += n;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    chunk.size = n;
+                    chunk.full = true;
+                }
+                condition.notify_all();
+
+                // Zero = end of the file, negative = error
+                if (n <= 0)
+                    return;
+            }
+        });
+
+        for (int i = 0;; i ^= 1)
+        {
+            Chunk& chunk = chunks[i];
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [&] { return chunk.full; });
+            }
+
+            if (chunk.size <= 0)
+            {
+                readError = chunk.size < 0;
+                break;
+            }
+
+            EVP_DigestUpdate(ctx.get(), chunk.buffer.get(), static_cast<size_t>(chunk.size));
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                chunk.full = false;
+            }
+            condition.notify_all();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        condition.notify_all();
+        reader.join();
+    }
+
+    if (readError)
+        throw YoutubedlFrontendException("Cannot read file: " + file.string());
+
+    unsigned char hash[EVP_MAX_MD_SIZE];
+    unsigned int hashLength = 0;
+    EVP_DigestFinal_ex(ctx.get(), hash, &hashLength);
+
+    static constexpr char HEX[] = "0123456789abcdef";
+    std::string result(hashLength * 2, '0');
+    for (unsigned int i = 0; i < hashLength; ++i)
+    {
+        result[2 * i] = HEX[hash[i] >> 4];
+        result[2 * i + 1] = HEX[hash[i] & 0x0f];
+    }
+    return result;
+}
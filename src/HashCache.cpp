@@ -0,0 +1,152 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "HashCache.h"
+#include "BinaryIo.h"
+#include "Utils.h"
+#include "YoutubedlFrontendException.h"
+
+#include <iostream>
+#include <sys/stat.h>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+HashCache::HashCache(const fs::path& file, std::string description, bool verify)
+    : file(file),
+      description(std::move(description)),
+      verify(verify)
+{
+    std::string data = Utils::readTextFromFile(file);
+    if (data.empty())
+        return;
+
+    try
+    {
+        BinaryReader reader(data);
+        if (reader.readUInt32() != MAGIC || reader.readUInt32() != VERSION)
+            return;
+
+        while (!reader.atEnd())
+        {
+            Key key;
+            key.device = static_cast<uint64_t>(reader.readInt64());
+            key.inode = static_cast<uint64_t>(reader.readInt64());
+            key.size = reader.readInt64();
+            key.mtime = reader.readInt64();
+            std::string hash(reader.readString());
+            hashes[key] = std::move(hash);
+        }
+    }
+    catch (const YoutubedlFrontendException&)
+    {
+        // Only a record cut off by the end is lost, the complete ones before it are kept
+        std::cerr << "[Warning] Damaged end of " << file.string() << ", " << this->description
+                  << " whose sums were cut off will be hashed again\n";
+        changed = true;
+    }
+}
+
+std::string HashCache::getSha512Hash(const fs::path& videoFile, bool* hashed)
+{
+    if (hashed)
+        *hashed = false;
+
+    struct stat st {};
+    if (::stat(videoFile.c_str(), &st) != 0)
+        throw YoutubedlFrontendException("File not found: " + videoFile.string());
+
+    Key key{
+        static_cast<uint64_t>(st.st_dev),
+        static_cast<uint64_t>(st.st_ino),
+        static_cast<int64_t>(st.st_size),
+        static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000L + st.st_mtim.tv_nsec
+    };
+
+    std::string cached;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = hashes.find(key);
+        if (it != hashes.end())
+        {
+            seen.insert(key);
+            if (!verify || verified.contains(key))
+                return it->second;
+            cached = it->second;
+        }
+    }
+
+    std::string hash = Utils::calculateSHA512Hash(videoFile);
+    if (hashed)
+        *hashed = true;
+
+    if (!cached.empty() && cached != hash)
+        reportMismatch(videoFile.string() + ": stored " + cached + ", now " + hash);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    hashes[key] = hash;
+    seen.insert(key);
+    if (verify)
+        verified.insert(key);
+    changed = true;
+    return hash;
+}
+
+void HashCache::reportMismatch(const std::string& message)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::cerr << "[Warning] Hash mismatch of " << description << ": " << message << "\n";
+    mismatches.push_back(message);
+}
+
+void HashCache::save(bool dropUnseen)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Sums of files which were deleted, replaced or modified since
+    if (dropUnseen && seen.size() < hashes.size())
+    {
+        std::erase_if(hashes, [this](const auto& entry) { return !seen.contains(entry.first); });
+        changed = true;
+    }
+
+    if (!changed)
+        return;
+
+    std::string out;
+    BinaryWriter writer(out);
+    writer.writeUInt32(MAGIC);
+    writer.writeUInt32(VERSION);
+    for (const auto& [key, hash] : hashes)
+    {
+        writer.writeInt64(static_cast<int64_t>(key.device));
+        writer.writeInt64(static_cast<int64_t>(key.inode));
+        writer.writeInt64(key.size);
+        writer.writeInt64(key.mtime);
+        writer.writeString(hash);
+    }
+
+    fs::create_directories(file.parent_path());
+    Utils::writeFileAtomically(out, file);
+    changed = false;
+}
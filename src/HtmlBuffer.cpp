@@ -0,0 +1,184 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "HtmlBuffer.h"
+#include "MappedFile.h"
+#include "YoutubedlFrontendException.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+static thread_local std::vector<std::unique_ptr<HtmlBuffer>> pool;
+
+HtmlBuffer::Pooled HtmlBuffer::acquire()
+{
+    if (pool.empty())
+        return Pooled(new HtmlBuffer());
+
+    Pooled buffer(pool.back().release());
+    pool.pop_back();
+    return buffer;
+}
+
+void HtmlBuffer::Release::operator()(HtmlBuffer* buffer) const
+{
+    buffer->clear();
+    while (buffer->totalCapacity > MAX_POOLED_CAPACITY && buffer->chunks.size() > 1)
+    {
+        buffer->totalCapacity -= buffer->chunks.back().capacity;
+        buffer->chunks.pop_back();
+    }
+    pool.emplace_back(buffer);
+}
+
+void HtmlBuffer::nextChunk()
+{
+    if (!chunks.empty() && chunks[current].size < chunks[current].capacity)
+        return;
+
+    if (!chunks.empty() && current + 1 < chunks.size())
+    {
+        ++current;
+        return;
+    }
+
+    // Every new chunk is as large as all previous ones together
+    size_t capacity = std::max(FIRST_CHUNK_SIZE, totalCapacity);
+    chunks.push_back(Chunk{std::make_unique_for_overwrite<char[]>(capacity), capacity});
+    totalCapacity += capacity;
+    current = chunks.size() - 1;
+}
+
+void HtmlBuffer::append(std::string_view text)
+{
+    while (!text.empty())
+    {
+        nextChunk();
+        Chunk& chunk = chunks[current];
+        size_t count = std::min(text.size(), chunk.capacity - chunk.size);
+        std::memcpy(chunk.data.get() + chunk.size, text.data(), count);
+        chunk.size += count;
+        totalSize += count;
+        text.remove_prefix(count);
+    }
+}
+
+HtmlBuffer& HtmlBuffer::appendFixed(double value, int precision)
+{
+    char digits[64];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, precision);
+    if (result.ec == std::errc())
+        append(std::string_view(digits, result.ptr));
+    return *this;
+}
+
+void HtmlBuffer::clear()
+{
+    for (auto& chunk : chunks)
+        chunk.size = 0;
+    current = 0;
+    totalSize = 0;
+}
+
+std::string HtmlBuffer::toString() const
+{
+    std::string text;
+    text.reserve(totalSize);
+    for (const auto& chunk : chunks)
+        text.append(chunk.data.get(), chunk.size);
+    return text;
+}
+
+bool HtmlBuffer::equals(std::string_view text) const
+{
+    if (text.size() != totalSize)
+        return false;
+
+    for (const auto& chunk : chunks)
+    {
+        if (text.substr(0, chunk.size) != std::string_view(chunk.data.get(), chunk.size))
+            return false;
+        text.remove_prefix(chunk.size);
+    }
+    return true;
+}
+
+void HtmlBuffer::writeToFile(const fs::path& file) const
+{
+    int fd = ::open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+        throw YoutubedlFrontendException("Cannot write to file: " + file.string() + ": " + std::strerror(errno));
+
+    std::vector<iovec> iov;
+    for (const auto& chunk : chunks)
+    {
+        if (chunk.size > 0)
+            iov.push_back(iovec{chunk.data.get(), chunk.size});
+    }
+
+    // writev() may write less than asked for, the rest is written again
+    size_t first = 0;
+    while (first < iov.size())
+    {
+        int count = static_cast<int>(std::min<size_t>(iov.size() - first, IOV_MAX));
+        ssize_t written = ::writev(fd, iov.data() + first, count);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            int error = errno;
+            ::close(fd);
+            throw YoutubedlFrontendException("Cannot write to file: " + file.string() + ": " + std::strerror(error));
+        }
+
+        auto left = static_cast<size_t>(written);
+        while (first < iov.size() && left >= iov[first].iov_len)
+            left -= iov[first++].iov_len;
+        if (left > 0)
+        {
+            iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + left;
+            iov[first].iov_len -= left;
+        }
+    }
+
+    if (::close(fd) != 0)
+        throw YoutubedlFrontendException("Cannot write to file: " + file.string() + ": " + std::strerror(errno));
+}
+
+bool HtmlBuffer::writeToFileIfChanged(const fs::path& file) const
+{
+    std::error_code ec;
+    auto size = fs::file_size(file, ec);
+    if (!ec && size == totalSize && equals(MappedFile(file).view()))
+        return false;
+
+    writeToFile(file);
+    return true;
+}
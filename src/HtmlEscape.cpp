@@ -0,0 +1,226 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "HtmlEscape.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+using Find = const char* (*)(const char* begin, const char* end);
+
+static constexpr size_t MAX_ENTITY_SIZE = 6; // &quot;
+
+static bool needsEscaping(char c)
+{
+    return c == '&' || c == '<' || c == '>' || c == '"' || c == '\'';
+}
+
+static std::string_view getEntity(char c)
+{
+    switch (c)
+    {
+    case '&': return "&amp;";
+    case '<': return "&lt;";
+    case '>': return "&gt;";
+    case '"': return "&quot;";
+    default:  return "&#39;";
+    }
+}
+
+// The first character which needs escaping, or end
+static const char* findScalar(const char* begin, const char* end)
+{
+    while (begin != end && !needsEscaping(*begin))
+        ++begin;
+    return begin;
+}
+
+#if defined(__SSE2__)
+static const char* findSse2(const char* begin, const char* end)
+{
+    const __m128i amp = _mm_set1_epi8('&');
+    const __m128i lt = _mm_set1_epi8('<');
+    const __m128i gt = _mm_set1_epi8('>');
+    const __m128i quot = _mm_set1_epi8('"');
+    const __m128i apos = _mm_set1_epi8('\'');
+
+    for (; end - begin >= 16; begin += 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        __m128i found = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(block, amp), _mm_cmpeq_epi8(block, lt)),
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, gt), _mm_cmpeq_epi8(block, quot)),
+                         _mm_cmpeq_epi8(block, apos)));
+        int mask = _mm_movemask_epi8(found);
+        if (mask != 0)
+            return begin + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+    return findScalar(begin, end);
+}
+#endif
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define HTML_ESCAPE_AVX2 1
+
+__attribute__((target("avx2")))
+static const char* findAvx2(const char* begin, const char* end)
+{
+    const __m256i amp = _mm256_set1_epi8('&');
+    const __m256i lt = _mm256_set1_epi8('<');
+    const __m256i gt = _mm256_set1_epi8('>');
+    const __m256i quot = _mm256_set1_epi8('"');
+    const __m256i apos = _mm256_set1_epi8('\'');
+
+    for (; end - begin >= 32; begin += 32)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        __m256i found = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, amp), _mm256_cmpeq_epi8(block, lt)),
+            _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, gt), _mm256_cmpeq_epi8(block, quot)),
+                            _mm256_cmpeq_epi8(block, apos)));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(found));
+        if (mask != 0)
+            return begin + __builtin_ctz(mask);
+    }
+
+    // Most comments and names are shorter than 32 bytes, or end with such a piece
+    if (end - begin >= 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        __m128i found = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(block, _mm256_castsi256_si128(amp)),
+                         _mm_cmpeq_epi8(block, _mm256_castsi256_si128(lt))),
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm256_castsi256_si128(gt)),
+                                      _mm_cmpeq_epi8(block, _mm256_castsi256_si128(quot))),
+                         _mm_cmpeq_epi8(block, _mm256_castsi256_si128(apos))));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(found));
+        if (mask != 0)
+            return begin + __builtin_ctz(mask);
+        begin += 16;
+    }
+    return findScalar(begin, end);
+}
+#endif
+
+bool HtmlEscape::isSupported(Implementation implementation)
+{
+    switch (implementation)
+    {
+    case Implementation::SCALAR:
+        return true;
+    case Implementation::SSE2:
+#if defined(__SSE2__)
+        return true;
+#else
+        return false;
+#endif
+    case Implementation::AVX2:
+#if defined(HTML_ESCAPE_AVX2)
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+HtmlEscape::Implementation HtmlEscape::getBest()
+{
+    static const Implementation best =
+        isSupported(Implementation::AVX2) ? Implementation::AVX2
+        : isSupported(Implementation::SSE2) ? Implementation::SSE2
+        : Implementation::SCALAR;
+    return best;
+}
+
+static Find getFind(HtmlEscape::Implementation implementation)
+{
+    switch (implementation)
+    {
+#if defined(HTML_ESCAPE_AVX2)
+    case HtmlEscape::Implementation::AVX2:
+        return findAvx2;
+#endif
+#if defined(__SSE2__)
+    case HtmlEscape::Implementation::SSE2:
+        return findSse2;
+#endif
+    default:
+        return findScalar;
+    }
+}
+
+// Writes the escaped text to out, which has room for 6 bytes per character
+static char* escapeInto(char* out, const char* begin, const char* end, Find find)
+{
+    while (true)
+    {
+        const char* special = find(begin, end);
+        std::memcpy(out, begin, special - begin);
+        out += special - begin;
+        if (special == end)
+            return out;
+        std::string_view entity = getEntity(*special);
+        std::memcpy(out, entity.data(), entity.size());
+        out += entity.size();
+        begin = special + 1;
+    }
+}
+
+static void appendEscaped(HtmlBuffer& out, std::string_view text, Find find)
+{
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+
+    // Usually the text fits into the current chunk even when all of it is escaped
+    if (char* space = out.getFreeSpace(text.size() * MAX_ENTITY_SIZE))
+    {
+        out.commit(escapeInto(space, begin, end, find) - space);
+        return;
+    }
+
+    while (begin != end)
+    {
+        const char* special = find(begin, end);
+        if (special != begin)
+            out.append(std::string_view(begin, special - begin));
+        if (special == end)
+            break;
+        out.append(getEntity(*special));
+        begin = special + 1;
+    }
+}
+
+void HtmlEscape::append(HtmlBuffer& out, std::string_view text)
+{
+    static const Find find = getFind(getBest());
+    appendEscaped(out, text, find);
+}
+
+void HtmlEscape::append(HtmlBuffer& out, std::string_view text, Implementation implementation)
+{
+    appendEscaped(out, text, getFind(isSupported(implementation) ? implementation : Implementation::SCALAR));
+}
@@ -0,0 +1,109 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "IoScheduler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <sys/sysmacros.h>
+
+IoScheduler::IoScheduler(TaskScheduler& scheduler, size_t concurrencyPerDevice)
+    : scheduler(scheduler),
+      concurrencyPerDevice(std::max<size_t>(1, concurrencyPerDevice))
+{
+}
+
+IoScheduler::~IoScheduler()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return running == 0; });
+}
+
+void IoScheduler::submit(uint64_t device, Job job)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    auto& d = devices[device];
+    if (!d)
+        d = std::make_unique<Device>();
+
+    if (d->running == concurrencyPerDevice)
+    {
+        d->jobs.push(std::move(job));
+        return;
+    }
+
+    ++d->running;
+    ++running;
+    if (d->jobCount++ == 0)
+        d->firstStart = Clock::now();
+    lock.unlock();
+    start(*d, std::move(job));
+}
+
+void IoScheduler::start(Device& device, Job job)
+{
+    scheduler.submit([this, &device, job = std::move(job)]() mutable { run(device, job); });
+}
+
+// Runs the job, then the next queued job of the device gets its place
+void IoScheduler::run(Device& device, Job& job)
+{
+    uint64_t bytes = job();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    device.bytes += bytes;
+    device.lastEnd = Clock::now();
+
+    if (!device.jobs.empty())
+    {
+        Job next = std::move(device.jobs.front());
+        device.jobs.pop();
+        ++device.jobCount;
+        lock.unlock();
+        start(device, std::move(next));
+        return;
+    }
+
+    --device.running;
+    if (--running == 0)
+        idle.notify_all();
+}
+
+void IoScheduler::printStatistics(std::ostream& out)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& [id, device] : devices)
+    {
+        double seconds = std::chrono::duration<double>(device->lastEnd - device->firstStart).count();
+        double megaBytes = static_cast<double>(device->bytes) / 1024.0 / 1024.0;
+        // Formatted apart, the caller's stream keeps its flags and precision
+        std::ostringstream line;
+        line << "Device " << major(static_cast<dev_t>(id)) << ":" << minor(static_cast<dev_t>(id)) << ": "
+             << device->jobCount << " files, "
+             << std::fixed << std::setprecision(1) << megaBytes << " MB read in "
+             << seconds << " s, "
+             << (seconds > 0 ? megaBytes / seconds : 0.0) << " MB/s\n";
+        out << line.str();
+    }
+}
@@ -0,0 +1,130 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "MediaProbe.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+
+extern "C" {
+#include <libavformat/avformat.h>
+#include <libavutil/mathematics.h>
+}
+
+namespace fs = std::filesystem;
+
+// The header of these containers is read within the first blocks of the file,
+// the MP4 demuxer seeks to the moov atom itself
+static constexpr const char* HEADER_PROBE_SIZE = "65536";
+static constexpr const char* HEADER_ANALYZE_DURATION = "0";
+
+// libavformat defaults, restored before the packets are analyzed
+static constexpr int64_t DEFAULT_PROBE_SIZE = 5000000;
+static constexpr int64_t DEFAULT_ANALYZE_DURATION = 0;
+
+void MediaProbe::init()
+{
+    static std::once_flag flag;
+    std::call_once(flag, [] { avformat_network_init(); });
+}
+
+static const char* getFormatName(const fs::path& file)
+{
+    std::string extension = file.extension().string();
+    if (extension == ".mkv" || extension == ".webm")
+        return "matroska";
+    if (extension == ".mp4" || extension == ".m4v" || extension == ".mov")
+        return "mp4";
+    return nullptr;
+}
+
+// Duration of the container, or of the longest stream when the container has none
+static std::optional<int64_t> getHeaderDuration(const AVFormatContext* fmtCtx)
+{
+    if (fmtCtx->duration != AV_NOPTS_VALUE && fmtCtx->duration > 0)
+        return fmtCtx->duration;
+
+    int64_t duration = 0;
+    for (unsigned int i = 0; i < fmtCtx->nb_streams; ++i)
+    {
+        const AVStream* stream = fmtCtx->streams[i];
+        if (stream->duration != AV_NOPTS_VALUE && stream->duration > 0)
+            duration = std::max(duration, av_rescale_q(stream->duration, stream->time_base, AV_TIME_BASE_Q));
+    }
+    if (duration > 0)
+        return duration;
+    return std::nullopt;
+}
+
+std::optional<int64_t> MediaProbe::getDuration(const fs::path& file)
+{
+    init();
+
+    const char* formatName = getFormatName(file);
+    if (!formatName)
+        return getDurationFromStreamInfo(file);
+
+    AVDictionary* options = nullptr;
+    av_dict_set(&options, "probesize", HEADER_PROBE_SIZE, 0);
+    av_dict_set(&options, "analyzeduration", HEADER_ANALYZE_DURATION, 0);
+
+    AVFormatContext* fmtCtx = nullptr;
+    int result = avformat_open_input(&fmtCtx, file.c_str(), av_find_input_format(formatName), &options);
+    av_dict_free(&options);
+
+    // The extension does not match the content
+    if (result < 0)
+        return getDurationFromStreamInfo(file);
+
+    std::optional<int64_t> duration = getHeaderDuration(fmtCtx);
+    if (!duration)
+    {
+        fmtCtx->probesize = DEFAULT_PROBE_SIZE;
+        fmtCtx->max_analyze_duration = DEFAULT_ANALYZE_DURATION;
+        if (avformat_find_stream_info(fmtCtx, nullptr) >= 0)
+            duration = fmtCtx->duration;
+    }
+
+    avformat_close_input(&fmtCtx);
+    return duration;
+}
+
+std::optional<int64_t> MediaProbe::getDurationFromStreamInfo(const fs::path& file)
+{
+    init();
+
+    AVFormatContext* fmtCtx = nullptr;
+    if (avformat_open_input(&fmtCtx, file.c_str(), nullptr, nullptr) < 0)
+        return std::nullopt;
+
+    if (avformat_find_stream_info(fmtCtx, nullptr) < 0)
+    {
+        avformat_close_input(&fmtCtx);
+        return std::nullopt;
+    }
+
+    int64_t duration = fmtCtx->duration;
+    avformat_close_input(&fmtCtx);
+    return duration;
+}
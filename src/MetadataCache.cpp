@@ -0,0 +1,289 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "MetadataCache.h"
+#include "BinaryIo.h"
+#include "Utils.h"
+#include "YoutubedlFrontendException.h"
+
+#include <algorithm>
+#include <array>
+#include <fcntl.h>
+#include <fstream>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+std::string MetadataCache::serialize(const YoutubeVideo& video)
+{
+    std::string out;
+    BinaryWriter writer(out);
+
+    writer.writeUInt32(MAGIC);
+    writer.writeUInt32(VERSION);
+
+    writer.writeString(video.id);
+    writer.writeString(video.snapshot);
+    writer.writeString(video.title);
+    writer.writeString(video.videoFileName);
+    writer.writeInt64(video.videoFileSizeInBytes);
+    writer.writeString(video.videoFileSha512HashSum);
+    writer.writeString(video.videoDuration);
+    writer.writeString(video.channelName);
+    writer.writeString(video.channelUrl);
+    writer.writeString(video.channelId);
+    writer.writeString(video.uploadDate);
+    writer.writeInt64(video.timestamp);
+    writer.writeString(video.description);
+    writer.writeString(video.thumbnail);
+    writer.writeString(video.miniThumbnail);
+
+    writer.writeUInt32(static_cast<uint32_t>(video.comments.size()));
+    for (const auto& comment : video.comments)
+    {
+        writer.writeString(comment.id);
+        writer.writeString(comment.parentId);
+        writer.writeString(comment.text);
+        writer.writeString(comment.author);
+        writer.writeInt64(comment.timestamp);
+        writer.writeUInt32(comment.depth);
+        writer.writeUInt32(comment.parent);
+        writer.writeUInt32(comment.replyCount);
+    }
+
+    writer.writeString(video.previousVideoId);
+    writer.writeString(video.nextVideoId);
+    writer.writeString(video.ext);
+    writer.writeInt64(video.number);
+
+    return out;
+}
+
+bool MetadataCache::deserialize(std::string_view data, YoutubeVideo& video)
+{
+    BinaryReader reader(data);
+
+    if (data.size() < 2 * sizeof(uint32_t) || reader.readUInt32() != MAGIC || reader.readUInt32() != VERSION)
+        return false;
+
+    video.id = reader.readString();
+    video.snapshot = reader.readString();
+    video.title = reader.readString();
+    video.videoFileName = reader.readString();
+    video.videoFileSizeInBytes = reader.readInt64();
+    video.videoFileSha512HashSum = reader.readString();
+    video.videoDuration = reader.readString();
+    video.channelName = reader.readString();
+    video.channelUrl = reader.readString();
+    video.channelId = reader.readString();
+    video.uploadDate = reader.readString();
+    video.timestamp = reader.readInt64();
+    video.description = reader.readString();
+    video.thumbnail = reader.readString();
+    video.miniThumbnail = reader.readString();
+
+    uint32_t commentCount = reader.readUInt32();
+    YoutubeComments::Builder comments;
+    for (uint32_t i = 0; i < commentCount; ++i)
+    {
+        std::string_view id = reader.readString();
+        std::string_view parentId = reader.readString();
+        std::string_view text = reader.readString();
+        std::string_view author = reader.readString();
+        long timestamp = static_cast<long>(reader.readInt64());
+        uint32_t depth = reader.readUInt32();
+        uint32_t parent = reader.readUInt32();
+        uint32_t replyCount = reader.readUInt32();
+
+        // A parent always precedes its replies in threaded order
+        if (parent != YoutubeComments::NO_PARENT && parent >= i)
+            return false;
+        comments.add(YoutubeComments::Comment{id, parentId, text, author, timestamp, depth, parent, replyCount});
+    }
+    // Stored in threaded order, with everything getThreaded() computed
+    video.comments = comments.build();
+
+    video.previousVideoId = reader.readString();
+    video.nextVideoId = reader.readString();
+    video.ext = reader.readString();
+    video.number = static_cast<int>(reader.readInt64());
+
+    return reader.atEnd();
+}
+
+// Reads at most maxSize bytes from the beginning of the file
+static bool readFile(const fs::path& file, std::string& data, size_t maxSize = SIZE_MAX)
+{
+    int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    struct stat st {};
+    bool ok = ::fstat(fd, &st) == 0;
+    if (ok)
+    {
+        data.resize(std::min(static_cast<size_t>(st.st_size), maxSize));
+        ok = ::read(fd, data.data(), data.size()) == static_cast<ssize_t>(data.size());
+    }
+    ::close(fd);
+    return ok;
+}
+
+bool MetadataCache::read(const fs::path& file, YoutubeVideo& video)
+{
+    std::string data;
+    if (!readFile(file, data))
+        return false;
+
+    try
+    {
+        return deserialize(data, video);
+    }
+    catch (const YoutubedlFrontendException&)
+    {
+        // Truncated file, it is generated again
+        return false;
+    }
+}
+
+bool MetadataCache::deserializeIds(std::string_view data, std::string& id, std::string& channelId)
+{
+    BinaryReader reader(data);
+
+    if (data.size() < 2 * sizeof(uint32_t) || reader.readUInt32() != MAGIC || reader.readUInt32() != VERSION)
+        return false;
+
+    try
+    {
+        id = reader.readString();
+        // snapshot, title, videoFileName, videoFileSizeInBytes, videoFileSha512HashSum,
+        // videoDuration, channelName and channelUrl are skipped
+        for (int i = 0; i < 3; ++i)
+            reader.readString();
+        reader.readInt64();
+        for (int i = 0; i < 4; ++i)
+            reader.readString();
+        channelId = reader.readString();
+        return true;
+    }
+    catch (const YoutubedlFrontendException&)
+    {
+        return false;
+    }
+}
+
+bool MetadataCache::readIds(const fs::path& file, std::string& id, std::string& channelId)
+{
+    // The ids precede the description and the comments, so a short prefix
+    // is enough unless the title or the channel fields are very long
+    std::string data;
+    if (!readFile(file, data, IDS_PREFIX_SIZE))
+        return false;
+    if (deserializeIds(data, id, channelId))
+        return true;
+    return data.size() == IDS_PREFIX_SIZE && readFile(file, data) && deserializeIds(data, id, channelId);
+}
+
+void MetadataCache::write(const fs::path& file, const YoutubeVideo& video)
+{
+    // An interrupted run keeps the previous file
+    Utils::writeFileAtomically(serialize(video), file);
+}
+
+bool MetadataCache::readLegacy(const fs::path& file, YoutubeVideo& video)
+{
+    std::ifstream ifs(file);
+    if (!ifs)
+        return false;
+
+    static const std::array<std::string, 20> KEYS{
+        "id", "snapshot", "title", "videoFileName", "videoFileSizeInBytes",
+        "videoFileSha512HashSum", "videoDuration", "channelName", "channelUrl", "channelId",
+        "uploadDate", "timestamp", "description", "thumbnail", "miniThumbnail",
+        "comments", "previousVideoId", "nextVideoId", "ext", "number"
+    };
+
+    std::map<std::string, std::string> props;
+    std::string lastKey;
+    std::string line;
+    while (std::getline(ifs, line))
+    {
+        auto pos = line.find('=');
+        std::string key = pos == std::string::npos ? "" : line.substr(0, pos);
+        if (std::find(KEYS.begin(), KEYS.end(), key) != KEYS.end())
+        {
+            props[key] = line.substr(pos + 1);
+            lastKey = key;
+        }
+        else if (!lastKey.empty())
+        {
+            // The old writer did not escape new lines, so this line continues
+            // a multi-line value, typically the description
+            props[lastKey] += "\n" + line;
+        }
+    }
+
+    try
+    {
+        video.id = props["id"];
+        video.snapshot = props["snapshot"];
+        video.title = props["title"];
+        video.videoFileName = props["videoFileName"];
+        video.videoFileSizeInBytes = std::stoll(props["videoFileSizeInBytes"]);
+        video.videoFileSha512HashSum = props["videoFileSha512HashSum"];
+        video.videoDuration = props["videoDuration"];
+        video.channelName = props["channelName"];
+        video.channelUrl = props["channelUrl"];
+        video.channelId = props["channelId"];
+        video.uploadDate = props["uploadDate"];
+        video.timestamp = std::stoll(props["timestamp"]);
+        video.description = props["description"];
+        video.thumbnail = props["thumbnail"];
+        video.miniThumbnail = props["miniThumbnail"];
+
+        YoutubeComments::Builder comments;
+        if (props.count("comments"))
+        {
+            for (auto& elem : json::parse(props["comments"]))
+                comments.add(YoutubeComment(elem));
+        }
+        // Older versions stored the comments ordered by timestamp only
+        video.comments = comments.build().getThreaded();
+
+        video.previousVideoId = props["previousVideoId"];
+        video.nextVideoId = props["nextVideoId"];
+        video.ext = props["ext"];
+        video.number = std::stoi(props["number"]);
+    }
+    catch (const std::exception&)
+    {
+        // Damaged legacy file, the metadata are generated again
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,104 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "PageFingerprints.h"
+#include "BinaryIo.h"
+#include "Utils.h"
+#include "YoutubedlFrontendException.h"
+
+#include <fstream>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+PageFingerprints::PageFingerprints(const fs::path& file)
+    : file(file)
+{
+    std::string data = Utils::readTextFromFile(file);
+    if (data.empty())
+        return;
+
+    try
+    {
+        BinaryReader reader(data);
+        if (reader.readUInt32() != MAGIC || reader.readUInt32() != VERSION)
+            return;
+
+        while (!reader.atEnd())
+        {
+            std::string page(reader.readString());
+            uint64_t fingerprint = static_cast<uint64_t>(reader.readInt64());
+            fingerprints[page] = fingerprint;
+        }
+    }
+    catch (const YoutubedlFrontendException&)
+    {
+        // Only the page cut off by the end is generated again
+        std::cerr << "[Warning] Damaged end of " << file.string() << ", it will be rewritten\n";
+        changed = true;
+    }
+}
+
+bool PageFingerprints::isUpToDate(const std::string& page, uint64_t fingerprint) const
+{
+    auto it = fingerprints.find(page);
+    return it != fingerprints.end() && it->second == fingerprint;
+}
+
+void PageFingerprints::update(const std::string& page, uint64_t fingerprint)
+{
+    seen.insert(page);
+    auto [it, inserted] = fingerprints.try_emplace(page, fingerprint);
+    if (inserted || it->second != fingerprint)
+    {
+        it->second = fingerprint;
+        changed = true;
+    }
+}
+
+void PageFingerprints::save(bool dropUnseen)
+{
+    // Pages of videos and channels which are no longer in the archive
+    if (dropUnseen && seen.size() < fingerprints.size())
+    {
+        std::erase_if(fingerprints, [this](const auto& entry) { return !seen.contains(entry.first); });
+        changed = true;
+    }
+
+    if (!changed)
+        return;
+
+    std::string out;
+    BinaryWriter writer(out);
+    writer.writeUInt32(MAGIC);
+    writer.writeUInt32(VERSION);
+    for (const auto& [page, fingerprint] : fingerprints)
+    {
+        writer.writeString(page);
+        writer.writeInt64(static_cast<int64_t>(fingerprint));
+    }
+
+    fs::create_directories(file.parent_path());
+    Utils::writeFileAtomically(out, file);
+    changed = false;
+}
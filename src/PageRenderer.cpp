@@ -0,0 +1,302 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "PageRenderer.h"
+#include "ChannelHtml.h"
+#include "Constants.h"
+#include "Progress.h"
+#include "TaskScheduler.h"
+#include "ThumbnailCache.h"
+#include "ThumbnailDerivatives.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// What a page task did, applied to the fingerprints by the calling thread
+struct RenderedPage {
+    std::string page; // relative to the ArchiveBox root, empty = no fingerprint
+    uint64_t fingerprint = 0;
+    bool rendered = false;
+};
+
+// The image inlined by --thumbnail-as-base64
+static fs::path getMiniThumbnailFile(const fs::path& archiveBoxRootDirectory, const YoutubeVideo& youtubeVideo)
+{
+    return archiveBoxRootDirectory / "archive" / youtubeVideo.snapshot / "media"
+           / ("mini-thumbnail." + youtubeVideo.getMiniThumbnailFormat());
+}
+
+// ------------------- fingerprints -----------------------
+// Everything a page is rendered from goes into its fingerprint.
+
+static uint64_t getVideoHtmlFingerprint(
+    const YoutubeVideo& youtubeVideo,
+    long countOfVideosInChannel,
+    const CommentPaging& commentPaging,
+    const fs::path& archiveBoxRootDirectory
+) {
+    // The fields the page shows, the comments by their digest, so an
+    // unchanged page costs no pass over its comments.
+    // Only the last video of a channel depends on the channel size (Next button),
+    // so adding a video does not invalidate all pages of the channel.
+    return Fingerprint()
+        .add(PAGE_FORMAT_VERSION)
+        .add(archiveBoxRootDirectory.string())
+        .add(youtubeVideo.id)
+        .add(youtubeVideo.snapshot)
+        .add(youtubeVideo.title)
+        .add(youtubeVideo.videoFileName)
+        .add(static_cast<int64_t>(youtubeVideo.videoFileSizeInBytes))
+        .add(youtubeVideo.thumbnail)
+        .add(youtubeVideo.description)
+        .add(youtubeVideo.number)
+        .add(youtubeVideo.previousVideoId)
+        .add(youtubeVideo.nextVideoId)
+        .add(static_cast<int64_t>(youtubeVideo.comments.getDigest()))
+        .add(youtubeVideo.number < countOfVideosInChannel ? 1 : 0)
+        .add(static_cast<int64_t>(commentPaging.threadsPerPage))
+        .add(static_cast<int64_t>(commentPaging.maxShards))
+        .get();
+}
+
+static uint64_t getChannelHtmlFingerprint(
+    const ChannelIndex& channelIndex,
+    const ChannelIndexEntry& channel,
+    const Config& config,
+    const fs::path& archiveBoxRootDirectory,
+    const ThumbnailDerivatives* thumbnailDerivatives
+) {
+    const bool thumbnailAsBase64 = config.thumbnailAsBase64;
+
+    Fingerprint fingerprint;
+    fingerprint
+        .add(PAGE_FORMAT_VERSION)
+        .add(channel.name)
+        .add(channel.url)
+        .add(config.videosPerRow)
+        .add(config.thumbnailLinksToYoutube ? 1 : 0)
+        .add(thumbnailAsBase64 ? 1 : 0);
+
+    if (thumbnailDerivatives) {
+        fingerprint.add(thumbnailDerivatives->getFormat());
+        for (int width : thumbnailDerivatives->getWidths())
+            fingerprint.add(width);
+    }
+
+    for (const auto& youtubeVideo : channelIndex.getVideos(channel)) {
+        fingerprint
+            .add(youtubeVideo.id)
+            .add(youtubeVideo.snapshot)
+            .add(youtubeVideo.title)
+            .add(youtubeVideo.uploadDate)
+            .add(youtubeVideo.videoDuration)
+            .add(youtubeVideo.number)
+            .add(youtubeVideo.miniThumbnail)
+            .add(youtubeVideo.thumbnail);
+
+        if (thumbnailAsBase64) {
+            // Inlined thumbnails depend on the image file itself
+            std::error_code ec;
+            fs::path thumbnailFile = getMiniThumbnailFile(archiveBoxRootDirectory, youtubeVideo);
+            fingerprint.add(static_cast<int64_t>(fs::last_write_time(thumbnailFile, ec).time_since_epoch().count()));
+        }
+
+        // A video without converted thumbnails keeps the downloaded one
+        if (thumbnailDerivatives)
+            fingerprint.add(thumbnailDerivatives->isAvailable(youtubeVideo) ? 1 : 0);
+    }
+
+    return fingerprint.get();
+}
+
+// Writes comments-<k>.html and removes the shards of a previous run with more of them
+static void writeCommentShards(
+    const fs::path& directory,
+    const std::vector<HtmlBuffer::Pooled>& shards
+) {
+    if (!shards.empty())
+        fs::create_directories(directory);
+
+    for (size_t k = 1; k <= shards.size(); ++k)
+        shards[k - 1]->writeToFileIfChanged(directory / ("comments-" + std::to_string(k) + ".html"));
+
+    for (size_t k = shards.size() + 1; fs::remove(directory / ("comments-" + std::to_string(k) + ".html")); ++k)
+        ;
+
+    std::error_code error;
+    if (shards.empty() && fs::is_directory(directory, error) && fs::is_empty(directory, error))
+        fs::remove(directory, error);
+}
+
+// ------------------- PageRenderer -----------------------
+
+PageRenderer::PageRenderer(
+    const ChannelIndex& channelIndex,
+    const Config& config,
+    const fs::path& archiveBoxRootDirectory
+) : channelIndex(channelIndex),
+    config(config),
+    archiveBoxRootDirectory(archiveBoxRootDirectory),
+    alwaysGenerateHtmlFiles(config.alwaysGenerateHtmlFiles)
+{
+    // Validated by Config
+    commentPaging.threadsPerPage = static_cast<size_t>(config.commentThreadsPerPage);
+    commentPaging.maxShards = static_cast<size_t>(config.maxCommentShards);
+}
+
+size_t PageRenderer::render(PageFingerprints& pageFingerprints, TaskScheduler& scheduler)
+{
+    const fs::path archiveBoxArchiveDirectory = archiveBoxRootDirectory / "archive";
+    const fs::path videosHtmlFile    = archiveBoxRootDirectory / "videos.html";
+    const fs::path videosDirectory   = archiveBoxRootDirectory / "videos";
+    const fs::path channelsDirectory = archiveBoxRootDirectory / "channels";
+
+    if (!fs::exists(videosDirectory))   fs::create_directories(videosDirectory);
+    if (!fs::exists(channelsDirectory)) fs::create_directories(channelsDirectory);
+
+    // Pages whose inputs did not change since the last run are skipped,
+    // unless --always-generate-html-files is set. The tasks only read the
+    // fingerprints, they are updated when all pages are done.
+    const PageFingerprints& previousFingerprints = pageFingerprints;
+
+    // Inlined thumbnails are resized once per changed image, not on every run
+    std::unique_ptr<ThumbnailCache> thumbnailCache;
+    if (config.thumbnailAsBase64)
+        thumbnailCache = std::make_unique<ThumbnailCache>(archiveBoxRootDirectory / STATE_DIRECTORY_NAME);
+
+    // Converted before the pages, which need to know which videos have them
+    std::unique_ptr<ThumbnailDerivatives> thumbnailDerivatives;
+    if (!config.thumbnailFormat.empty()) {
+        thumbnailDerivatives = std::make_unique<ThumbnailDerivatives>(
+            archiveBoxRootDirectory, config.thumbnailFormat, config.thumbnailWidths);
+        thumbnailDerivatives->generate(channelIndex, scheduler, config.statusFile);
+    }
+
+    struct VideoPage {
+        const YoutubeVideo* youtubeVideo;
+        long countOfVideosInChannel;
+    };
+    std::vector<VideoPage> videoPages;
+    for (const auto& channel : channelIndex.getChannels()) {
+        for (const auto& youtubeVideo : channelIndex.getVideos(channel))
+            videoPages.push_back({&youtubeVideo, static_cast<long>(channel.videoCount)});
+    }
+    const auto& channels = channelIndex.getChannels();
+
+    // Videos first, then the channels and the master list (wantedChannel = null)
+    std::vector<RenderedPage> results(videoPages.size() + channels.size() + 1);
+
+    auto renderVideo = [&](const VideoPage& videoPage, RenderedPage& result) {
+        const YoutubeVideo& youtubeVideo = *videoPage.youtubeVideo;
+        result.page = "videos/" + youtubeVideo.id + ".html";
+        result.fingerprint = getVideoHtmlFingerprint(youtubeVideo,
+                                                     videoPage.countOfVideosInChannel,
+                                                     commentPaging,
+                                                     archiveBoxRootDirectory);
+
+        fs::path videoHtmlFile = videosDirectory / (youtubeVideo.id + ".html");
+        if (!alwaysGenerateHtmlFiles &&
+            previousFingerprints.isUpToDate(result.page, result.fingerprint) &&
+            fs::exists(videoHtmlFile))
+            return;
+
+        YoutubeVideoHtml videoHtml(youtubeVideo,
+                                   archiveBoxRootDirectory,
+                                   archiveBoxArchiveDirectory,
+                                   videoPage.countOfVideosInChannel,
+                                   commentPaging);
+
+        videoHtml.getPage().writeToFileIfChanged(videoHtmlFile);
+        writeCommentShards(videosDirectory / youtubeVideo.id, videoHtml.getCommentShards());
+        result.rendered = true;
+    };
+
+    auto renderChannel = [&](const ChannelIndexEntry& channel, RenderedPage& result) {
+        result.page = "channels/" + channel.id + ".html";
+        result.fingerprint = getChannelHtmlFingerprint(channelIndex, channel,
+                                                       config, archiveBoxRootDirectory,
+                                                       thumbnailDerivatives.get());
+
+        fs::path channelHtmlFile = channelsDirectory / (channel.id + ".html");
+        if (!alwaysGenerateHtmlFiles &&
+            previousFingerprints.isUpToDate(result.page, result.fingerprint) &&
+            fs::exists(channelHtmlFile)) {
+            // Its inlined thumbnails stay in the cache
+            if (thumbnailCache) {
+                for (const auto& youtubeVideo : channelIndex.getVideos(channel))
+                    thumbnailCache->keep(getMiniThumbnailFile(archiveBoxRootDirectory, youtubeVideo));
+            }
+            return;
+        }
+
+        ChannelHtml channelHtml(channelIndex, &channel, config, archiveBoxRootDirectory,
+                                thumbnailCache.get(), thumbnailDerivatives.get());
+        channelHtml.getPage().writeToFileIfChanged(channelHtmlFile);
+        result.rendered = true;
+    };
+
+    auto renderPage = [&](size_t i) {
+        if (i < videoPages.size()) {
+            renderVideo(videoPages[i], results[i]);
+        } else if (i < videoPages.size() + channels.size()) {
+            renderChannel(channels[i - videoPages.size()], results[i]);
+        } else {
+            // The master list is cheap to render
+            ChannelHtml masterList(channelIndex, nullptr, config, archiveBoxRootDirectory);
+            masterList.getPage().writeToFileIfChanged(videosHtmlFile);
+            results[i].rendered = true;
+        }
+    };
+
+    // The total is known up front, the tasks only count
+    Progress progress("Rendering", "pages", results.size(), std::cerr, config.statusFile);
+
+    auto renderAndCount = [&](size_t i) {
+        renderPage(i);
+        progress.advance();
+    };
+
+    TaskGroup pages(scheduler);
+    pages.runBatch(results.size(), renderAndCount);
+    pages.wait();
+    progress.finish();
+
+    // A run limited by --video or --channel did not see the other thumbnails
+    if (thumbnailCache)
+        thumbnailCache->save(config.video.empty() && config.channel.empty());
+
+    // Skipped pages are up to date, updating them only marks them as seen
+    size_t renderedPages = 0;
+    for (const auto& result : results) {
+        if (result.rendered)
+            ++renderedPages;
+        if (!result.page.empty())
+            pageFingerprints.update(result.page, result.fingerprint);
+    }
+    return renderedPages;
+}
@@ -0,0 +1,131 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Progress.h"
+
+#include <cstdio>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace fs = std::filesystem;
+
+Progress::Progress(std::string stage, std::string unit, size_t total,
+                   std::ostream& out, fs::path statusFile)
+    : stage(std::move(stage)),
+      unit(std::move(unit)),
+      out(out),
+      statusFile(std::move(statusFile)),
+      start(Clock::now()),
+      total(total),
+      nextReport(Clock::duration(REPORT_INTERVAL).count())
+{
+}
+
+static std::string formatDuration(double seconds)
+{
+    long s = static_cast<long>(seconds + 0.5);
+    char buf[32];
+    if (s >= 3600)
+        std::snprintf(buf, sizeof(buf), "%ld:%02ld:%02ld", s / 3600, s / 60 % 60, s % 60);
+    else
+        std::snprintf(buf, sizeof(buf), "%ld:%02ld", s / 60, s % 60);
+    return buf;
+}
+
+void Progress::report(bool finished)
+{
+    // A slow report is skipped rather than waited for
+    std::unique_lock<std::mutex> lock(reportMutex, std::defer_lock);
+    if (finished)
+        lock.lock();
+    else if (!lock.try_lock())
+        return;
+
+    size_t doneNow = done.load();
+    size_t totalNow = total.load();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    double perSecond = seconds > 0 ? doneNow / seconds : 0;
+
+    char rate[32];
+    std::snprintf(rate, sizeof(rate), "%.1f", perSecond);
+
+    if (finished) {
+        out << stage << ": " << doneNow << " " << unit << " in " << formatDuration(seconds)
+            << ", " << rate << " " << unit << "/s\n";
+    } else {
+        out << stage << ": " << doneNow;
+        if (totalNow > 0) {
+            char percent[16];
+            std::snprintf(percent, sizeof(percent), "%.1f", 100.0 * doneNow / totalNow);
+            out << "/" << totalNow << " " << unit << " (" << percent << "%)";
+        } else {
+            out << " " << unit;
+        }
+        out << ", " << rate << " " << unit << "/s";
+        if (totalNow > doneNow && perSecond > 0)
+            out << ", ETA " << formatDuration((totalNow - doneNow) / perSecond);
+        out << "\n";
+    }
+    out.flush();
+
+    writeStatusFile(doneNow, totalNow, seconds, finished);
+}
+
+void Progress::writeStatusFile(size_t doneNow, size_t totalNow, double seconds, bool finished)
+{
+    if (statusFile.empty())
+        return;
+
+    double perSecond = seconds > 0 ? doneNow / seconds : 0;
+    nlohmann::json status {
+        {"stage", stage},
+        {"unit", unit},
+        {"done", doneNow},
+        {"total", totalNow},
+        {"elapsedSeconds", seconds},
+        {"perSecond", perSecond},
+        {"finished", finished}
+    };
+    if (totalNow > doneNow && perSecond > 0)
+        status["etaSeconds"] = (totalNow - doneNow) / perSecond;
+    else
+        status["etaSeconds"] = nullptr;
+
+    // Written next to it and renamed, so a reader never sees a partial file.
+    // A failure is not fatal, the file is only informative.
+    fs::path temporary = statusFile;
+    temporary += ".tmp";
+    {
+        std::ofstream ofs(temporary, std::ios::trunc);
+        if (!ofs)
+            return;
+        ofs << status.dump() << "\n";
+    }
+    std::error_code ec;
+    fs::rename(temporary, statusFile, ec);
+}
+
+void Progress::finish()
+{
+    report(true);
+}
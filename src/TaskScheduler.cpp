@@ -0,0 +1,231 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "TaskScheduler.h"
+
+#include <chrono>
+
+// The scheduler and the index of the worker running on this thread
+static thread_local const TaskScheduler* currentScheduler = nullptr;
+static thread_local size_t currentWorker = 0;
+
+void TaskScheduler::Deque::grow()
+{
+    size_t newCapacity = capacity == 0 ? 64 : capacity * 2;
+    auto newTasks = std::make_unique<Task[]>(newCapacity);
+    for (size_t i = 0; i < count; ++i)
+        newTasks[i] = std::move(tasks[(head + i) & (capacity - 1)]);
+    tasks = std::move(newTasks);
+    capacity = newCapacity;
+    head = 0;
+}
+
+TaskScheduler::TaskScheduler(size_t threadCount)
+{
+    threadCount = std::max<size_t>(1, threadCount);
+    for (size_t i = 0; i < threadCount; ++i)
+        workers.push_back(std::make_unique<Worker>());
+    for (size_t i = 0; i < threadCount; ++i)
+        workers[i]->thread = std::thread([this, i] { work(i); });
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stop = true;
+    }
+    wakeUp.notify_all();
+    for (auto& worker : workers)
+        worker->thread.join();
+}
+
+size_t TaskScheduler::getDefaultThreadCount()
+{
+    return std::max(2u, std::thread::hardware_concurrency());
+}
+
+size_t TaskScheduler::getCurrentWorker() const
+{
+    return currentScheduler == this ? currentWorker : workers.size();
+}
+
+void TaskScheduler::push(size_t worker, Task&& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(workers[worker]->mutex);
+        workers[worker]->tasks.pushBack(std::move(task));
+    }
+    queued.fetch_add(1);
+    wake(1);
+}
+
+void TaskScheduler::submit(Task task)
+{
+    size_t worker = getCurrentWorker();
+    if (worker == workers.size())
+        worker = nextWorker.fetch_add(1) % workers.size();
+    push(worker, std::move(task));
+}
+
+void TaskScheduler::wake(size_t tasks)
+{
+    // queued was increased before, a worker going to sleep checks it after increasing sleeping
+    if (sleeping.load() == 0)
+        return;
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    if (tasks == 1)
+        wakeUp.notify_one();
+    else
+        wakeUp.notify_all();
+}
+
+bool TaskScheduler::pop(size_t worker, Task& task)
+{
+    Worker& w = *workers[worker];
+    std::lock_guard<std::mutex> lock(w.mutex);
+    if (w.tasks.empty())
+        return false;
+    task = w.tasks.popBack();
+    return true;
+}
+
+bool TaskScheduler::steal(size_t thief, Task& task)
+{
+    // A thread which is not a worker takes one task only
+    bool keepRest = thief < workers.size();
+    size_t start = keepRest ? thief + 1 : nextWorker.load();
+
+    for (size_t i = 0; i < workers.size(); ++i) {
+        size_t victimIndex = (start + i) % workers.size();
+        if (victimIndex == thief)
+            continue;
+
+        Task stolen[MAX_STOLEN];
+        size_t stolenCount = 0;
+        {
+            Worker& victim = *workers[victimIndex];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.tasks.empty())
+                continue;
+            size_t take = keepRest ? std::min(MAX_STOLEN, (victim.tasks.size() + 1) / 2) : 1;
+            for (; stolenCount < take; ++stolenCount)
+                stolen[stolenCount] = victim.tasks.popFront();
+        }
+
+        task = std::move(stolen[0]);
+        if (stolenCount > 1) {
+            // The oldest task runs now, the others are the thief's next ones
+            Worker& own = *workers[thief];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            for (size_t k = stolenCount; k-- > 1;)
+                own.tasks.pushBack(std::move(stolen[k]));
+        }
+        return true;
+    }
+    return false;
+}
+
+bool TaskScheduler::runOne()
+{
+    size_t worker = getCurrentWorker();
+    Task task;
+    bool found = (worker < workers.size() && pop(worker, task)) || steal(worker, task);
+    if (!found)
+        return false;
+    queued.fetch_sub(1);
+    task();
+    return true;
+}
+
+void TaskScheduler::work(size_t worker)
+{
+    currentScheduler = this;
+    currentWorker = worker;
+
+    for (;;) {
+        Task task;
+        if (pop(worker, task) || steal(worker, task)) {
+            queued.fetch_sub(1);
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleeping.fetch_add(1);
+        wakeUp.wait(lock, [this] { return stop || queued.load() > 0; });
+        sleeping.fetch_sub(1);
+        if (stop && queued.load() == 0)
+            return;
+    }
+}
+
+// ------------------- TaskGroup -----------------------
+
+TaskGroup::~TaskGroup()
+{
+    try {
+        wait();
+    } catch (...) {
+        // The exception was not waited for
+    }
+}
+
+void TaskGroup::finish(std::exception_ptr taskError)
+{
+    if (taskError) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+            error = taskError;
+    }
+
+    size_t left = pending.load();
+    while (left > 1) {
+        if (pending.compare_exchange_weak(left, left - 1))
+            return;
+    }
+
+    // The last task decreases the counter under the lock, so wait()
+    // cannot return and destroy the group before it is done with it
+    std::lock_guard<std::mutex> lock(mutex);
+    if (pending.fetch_sub(1) == 1)
+        finished.notify_all();
+}
+
+void TaskGroup::wait()
+{
+    while (pending.load() > 0) {
+        if (scheduler.runOne())
+            continue;
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait_for(lock, std::chrono::milliseconds(1), [this] { return pending.load() == 0; });
+    }
+
+    std::exception_ptr taskError;
+    {
+        std::lock_guard<std::mutex> lock(mutex); // after the last finish()
+        taskError = std::exchange(error, nullptr);
+    }
+    if (taskError)
+        std::rethrow_exception(taskError);
+}
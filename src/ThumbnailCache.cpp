@@ -0,0 +1,137 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ThumbnailCache.h"
+#include "Utils.h"
+#include "YoutubedlFrontendException.h"
+
+#include <exception>
+
+namespace fs = std::filesystem;
+
+ThumbnailCache::ThumbnailCache(const fs::path& stateDirectory)
+    : directory(stateDirectory / DIRECTORY_NAME),
+      sourceHashes(stateDirectory / HASHES_FILE_NAME, "thumbnails", false)
+{
+}
+
+ThumbnailCache::Image ThumbnailCache::resize(const fs::path& source, int width, int height, const std::string& format)
+{
+    try {
+        return std::make_shared<const std::vector<uint8_t>>(Utils::resizeImage(source, width, height, format));
+    } catch (const std::exception&) {
+        // A missing or broken image is inlined as an empty one
+        return std::make_shared<const std::vector<uint8_t>>();
+    }
+}
+
+std::string ThumbnailCache::getSourcePrefix(const fs::path& source)
+{
+    std::string sourceHash;
+    try {
+        sourceHash = sourceHashes.getSha512Hash(source);
+    } catch (const std::exception&) {
+        return "";
+    }
+
+    // 128 bits of the sum are enough to tell the images apart
+    std::string prefix = sourceHash.substr(0, 32);
+    std::lock_guard<std::mutex> lock(mutex);
+    usedSources.insert(prefix);
+    return prefix;
+}
+
+ThumbnailCache::Image ThumbnailCache::get(const fs::path& source, int width, int height, const std::string& format)
+{
+    std::string prefix = getSourcePrefix(source);
+    if (prefix.empty())
+        return std::make_shared<const std::vector<uint8_t>>();
+
+    std::string key = prefix + "-" + std::to_string(width) + "x"
+                      + std::to_string(height) + "." + format;
+
+    std::promise<Image> promise;
+    std::shared_future<Image> image;
+    bool loading = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto [it, inserted] = images.try_emplace(key);
+        if (inserted) {
+            it->second = promise.get_future().share();
+            loading = true;
+        }
+        image = it->second;
+    }
+
+    if (loading) {
+        try {
+            promise.set_value(load(key, source, width, height, format));
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    }
+    return image.get();
+}
+
+ThumbnailCache::Image ThumbnailCache::load(const std::string& key, const fs::path& source,
+                                           int width, int height, const std::string& format)
+{
+    fs::path file = directory / key;
+    std::string stored = Utils::readTextFromFile(file);
+    if (!stored.empty())
+        return std::make_shared<const std::vector<uint8_t>>(stored.begin(), stored.end());
+
+    Image image = resize(source, width, height, format);
+    if (image->empty())
+        return image; // tried again in the next run
+
+    // An interrupted run or a full disk leaves no partial entry
+    try {
+        fs::create_directories(directory);
+        Utils::writeFileAtomically(std::string_view(reinterpret_cast<const char*>(image->data()), image->size()), file);
+    } catch (const std::exception&) {
+        // Inlined anyway, stored in the next run
+    }
+    return image;
+}
+
+void ThumbnailCache::keep(const fs::path& source)
+{
+    getSourcePrefix(source);
+}
+
+void ThumbnailCache::save(bool prune)
+{
+    sourceHashes.save(prune);
+    if (!prune)
+        return;
+
+    // Entries of deleted or replaced images
+    std::error_code ec;
+    for (auto it = fs::directory_iterator(directory, ec); !ec && it != fs::directory_iterator(); it.increment(ec)) {
+        std::string name = it->path().filename().string();
+        std::error_code removeError;
+        if (!usedSources.contains(name.substr(0, name.find('-'))))
+            fs::remove(it->path(), removeError);
+    }
+}
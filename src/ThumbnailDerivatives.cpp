@@ -0,0 +1,166 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ThumbnailDerivatives.h"
+#include "Progress.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+ThumbnailDerivatives::ThumbnailDerivatives(const fs::path& archiveBoxRootDirectory,
+                                           std::string format,
+                                           std::vector<int> widths)
+    : archiveDirectory(archiveBoxRootDirectory / "archive"),
+      directory(archiveBoxRootDirectory / DIRECTORY_NAME),
+      format(std::move(format)),
+      widths(std::move(widths))
+{
+}
+
+std::string ThumbnailDerivatives::getFileName(int width) const
+{
+    return "thumbnail-" + std::to_string(width) + "." + format;
+}
+
+int ThumbnailDerivatives::getDefaultWidth(int cellWidth) const
+{
+    auto it = std::lower_bound(widths.begin(), widths.end(), cellWidth);
+    return it != widths.end() ? *it : widths.back();
+}
+
+bool ThumbnailDerivatives::generate(const YoutubeVideo& youtubeVideo, bool& converted) const
+{
+    fs::path mediaDirectory = archiveDirectory / youtubeVideo.snapshot / "media";
+
+    // The full thumbnail, the mini one when it was not downloaded
+    std::error_code error;
+    fs::path source = mediaDirectory / ("thumbnail." + youtubeVideo.getThumbnailFormat());
+    fs::file_time_type sourceTime = fs::last_write_time(source, error);
+    if (error) {
+        error.clear();
+        source = mediaDirectory / ("mini-thumbnail." + youtubeVideo.getMiniThumbnailFormat());
+        sourceTime = fs::last_write_time(source, error);
+        if (error)
+            return false;
+    }
+
+    fs::path snapshotDirectory = directory / youtubeVideo.snapshot;
+    std::vector<std::pair<int, int>> sizes;
+    std::vector<fs::path> files;
+    for (int width : widths) {
+        // An empty file is left by a power loss after the rename, see writeFileAtomically
+        fs::path file = snapshotDirectory / getFileName(width);
+        fs::file_time_type time = fs::last_write_time(file, error);
+        if (!error && time >= sourceTime && fs::file_size(file, error) > 0 && !error)
+            continue;
+        error.clear();
+        sizes.emplace_back(width, getHeight(width));
+        files.push_back(std::move(file));
+    }
+    if (sizes.empty())
+        return true;
+
+    try {
+        std::vector<std::vector<uint8_t>> images = Utils::cropAndResizeImage(source, sizes, format);
+
+        // An interrupted run or a full disk leaves no partial file, which
+        // would be newer than the source and never made again
+        fs::create_directories(snapshotDirectory);
+        for (size_t i = 0; i < files.size(); ++i)
+            Utils::writeFileAtomically(std::string_view(reinterpret_cast<const char*>(images[i].data()),
+                                                        images[i].size()), files[i]);
+    } catch (const std::exception&) {
+        // The page keeps the downloaded thumbnail, tried again in the next run
+        return false;
+    }
+    converted = true;
+    return true;
+}
+
+void ThumbnailDerivatives::removeUnreferenced() const
+{
+    std::unordered_set<std::string> fileNames;
+    for (int width : widths)
+        fileNames.insert(getFileName(width));
+
+    // By the archive itself, so a run limited by --video or --channel keeps the others
+    std::error_code error;
+    for (auto it = fs::directory_iterator(directory, error); !error && it != fs::directory_iterator(); it.increment(error)) {
+        std::error_code removeError;
+        if (!fs::is_directory(archiveDirectory / it->path().filename() / "media", removeError)) {
+            fs::remove_all(it->path(), removeError);
+            continue;
+        }
+        for (auto file = fs::directory_iterator(it->path(), removeError);
+             !removeError && file != fs::directory_iterator(); file.increment(removeError)) {
+            std::error_code fileError;
+            if (!fileNames.contains(file->path().filename().string()))
+                fs::remove(file->path(), fileError);
+        }
+    }
+}
+
+size_t ThumbnailDerivatives::generate(const ChannelIndex& channelIndex, TaskScheduler& scheduler,
+                                      const fs::path& statusFile)
+{
+    std::vector<const YoutubeVideo*> videos;
+    for (const auto& channel : channelIndex.getChannels()) {
+        for (const auto& youtubeVideo : channelIndex.getVideos(channel))
+            videos.push_back(&youtubeVideo);
+    }
+
+    struct Result {
+        bool available = false;
+        bool converted = false;
+    };
+    std::vector<Result> results(videos.size());
+
+    Progress progress("Converting", "thumbnails", videos.size(), std::cerr, statusFile);
+
+    auto convert = [&](size_t i) {
+        results[i].available = generate(*videos[i], results[i].converted);
+        progress.advance();
+    };
+
+    TaskGroup group(scheduler);
+    group.runBatch(videos.size(), convert);
+    group.wait();
+    progress.finish();
+
+    available.clear();
+    size_t converted = 0;
+    for (size_t i = 0; i < videos.size(); ++i) {
+        if (results[i].available)
+            available.insert(videos[i]->snapshot);
+        if (results[i].converted)
+            ++converted;
+    }
+
+    removeUnreferenced();
+    return converted;
+}
@@ -28,6 +28,7 @@
 #include <iostream>
 #include <opencv2/opencv.hpp>
 #include "YoutubedlFrontendException.h"
+#include "FileHasher.h"
 #include <curl/curl.h>
 
 std::string Utils::replaceUnderscoresBySpaces(const std::string& s)
@@ -90,6 +91,23 @@ void Utils::writeTextToFile(const std::string& text, const fs::path& file)
     ofs << text;
 }
 
+void Utils::writeFileAtomically(std::string_view data, const fs::path& file)
+{
+    fs::path temporaryFile = file;
+    temporaryFile += ".tmp";
+
+    std::ofstream ofs(temporaryFile, std::ios::binary | std::ios::trunc);
+    ofs.write(data.data(), static_cast<std::streamsize>(data.size()));
+    ofs.close();
+    if (!ofs)
+    {
+        std::error_code ec;
+        fs::remove(temporaryFile, ec);
+        throw YoutubedlFrontendException("Cannot write to file: " + file.string());
+    }
+    fs::rename(temporaryFile, file);
+}
+
 std::string Utils::readTextFromFile(const fs::path& file)
 {
     if (!fs::exists(file))
@@ -109,25 +127,8 @@ std::string Utils::calculateSHA512Hash(const fs::path& file)
     if (!fs::exists(file))
         throw std::runtime_error("File not found: " + file.string());
 
-    std::ifstream ifs(file, std::ios::binary);
-    SHA512_CTX ctx;
-    SHA512_Init(&ctx);
-
-    std::array<char, 4096> buf;
-    while (ifs.good())
-    {
-        ifs.read(buf.data(), buf.size());
-        SHA512_Update(&ctx, buf.data(), ifs.gcount());
-    }
-
-    unsigned char hash[SHA512_DIGEST_LENGTH];
-    SHA512_Final(hash, &ctx);
-
-    std::ostringstream oss;
-    for (unsigned char c : hash)
-        oss << std::hex << std::setw(2) << std::setfill('0') << (int)c;
-
-    return oss.str();
+    static const FileHasher hasher("sha512");
+    return hasher.hashFile(file);
 }
 
 bool Utils::convertStringToBoolean(const std::string& s)
@@ -157,6 +158,50 @@ std::vector<uint8_t> Utils::resizeImage(const fs::path& input,
 }
 
 
+std::vector<std::vector<uint8_t>> Utils::cropAndResizeImage(const fs::path& input,
+                                                            const std::vector<std::pair<int, int>>& sizes,
+                                                            const std::string& format)
+{
+    cv::Mat src = cv::imread(input.string());
+    if (src.empty())
+        throw std::runtime_error("Could not read image: " + input.string());
+
+    std::vector<int> params;
+    if (format == "webp")
+        params = {cv::IMWRITE_WEBP_QUALITY, 80};
+    else if (format == "jpg" || format == "jpeg")
+        params = {cv::IMWRITE_JPEG_QUALITY, 85};
+
+    std::vector<std::vector<uint8_t>> images;
+    for (const auto& [width, height] : sizes)
+    {
+        // The largest centred part of the source with the target aspect ratio
+        int cropWidth = src.cols;
+        int cropHeight = static_cast<int>(static_cast<int64_t>(src.cols) * height / width);
+        if (cropHeight > src.rows)
+        {
+            cropHeight = src.rows;
+            cropWidth = static_cast<int>(static_cast<int64_t>(src.rows) * width / height);
+        }
+        cv::Mat cropped = src(cv::Rect((src.cols - cropWidth) / 2, (src.rows - cropHeight) / 2, cropWidth, cropHeight));
+
+        cv::Mat dst;
+        cv::resize(cropped, dst, cv::Size(width, height), 0, 0, cv::INTER_AREA);
+
+        std::vector<uint8_t> buf;
+        if (!cv::imencode("." + format, dst, buf, params))
+            throw std::runtime_error("Image encoding failed");
+        images.push_back(std::move(buf));
+    }
+    return images;
+}
+
+bool Utils::canEncodeImage(const std::string& format)
+{
+    return cv::haveImageWriter("." + format);
+}
+
+
 void Utils::downloadFile(const std::string& url, const fs::path& target)
 {
     CURL* curl = curl_easy_init();
@@ -52,53 +52,3 @@ bool YoutubeComment::operator<(const YoutubeComment& other) const
 {
     return timestamp < other.timestamp;
 }
-
-int YoutubeComment::dotCount() const
-{
-    int count = 0;
-    for (char c : id)
-    {
-        if (c == '.')
-            count++;
-    }
-    return count;
-}
-
-std::vector<YoutubeComment> YoutubeComment::sort(const std::vector<YoutubeComment>& list)
-{
-    // Get root comments
-    std::vector<YoutubeComment> root = getChildren(list, "root");
-
-    // Sort roots by timestamp
-    std::sort(root.begin(), root.end());
-
-    return root;
-}
-
-std::vector<YoutubeComment> YoutubeComment::getChildren(
-    const std::vector<YoutubeComment>& all,
-    const std::string& parentId
-)
-{
-    // Filter children with matching parentId
-    std::vector<YoutubeComment> children;
-    for (auto& c : all)
-    {
-        if (c.parentId == parentId)
-            children.push_back(c);
-    }
-
-    // Sort them (oldest first)
-    std::sort(children.begin(), children.end());
-
-    // Recursively add children under each child
-    std::vector<YoutubeComment> result;
-    for (auto& c : children)
-    {
-        result.push_back(c);
-        auto sub = getChildren(all, c.id);
-        result.insert(result.end(), sub.begin(), sub.end());
-    }
-
-    return result;
-}
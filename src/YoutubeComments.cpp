@@ -0,0 +1,257 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "YoutubeComments.h"
+#include "YoutubedlFrontendException.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+
+YoutubeComments::YoutubeComments(std::shared_ptr<const Data> data)
+    : data(std::move(data))
+{
+}
+
+uint64_t YoutubeComments::computeDigest(const Strings& strings, const std::vector<Record>& records)
+{
+    // By content, not by string index, so the same comments read from the
+    // info JSON or from the metadata file have the same digest
+    uint64_t digest = records.size();
+    auto mix = [&digest](uint64_t value) {
+        digest ^= value + 0x9e3779b97f4a7c15ULL + (digest << 6) + (digest >> 2);
+    };
+    std::hash<std::string_view> hash;
+    for (const Record& record : records)
+    {
+        mix(hash(strings.get(record.id)));
+        mix(hash(strings.get(record.parentId)));
+        mix(hash(strings.get(record.text)));
+        mix(hash(strings.get(record.author)));
+        mix(static_cast<uint64_t>(record.timestamp));
+        mix(record.depth);
+        mix(record.parent);
+        mix(record.replyCount);
+    }
+    return digest;
+}
+
+YoutubeComments::Comment YoutubeComments::operator[](size_t index) const
+{
+    const Record& record = data->records[index];
+    const Strings& strings = *data->strings;
+    return Comment{
+        strings.get(record.id),
+        strings.get(record.parentId),
+        strings.get(record.text),
+        strings.get(record.author),
+        static_cast<long>(record.timestamp),
+        record.depth,
+        record.parent,
+        record.replyCount
+    };
+}
+
+YoutubeComments::Builder::Builder()
+    : strings(std::make_shared<Strings>()),
+      table(64, 0)
+{
+}
+
+uint32_t YoutubeComments::Builder::append(std::string_view value)
+{
+    if (strings->buffer.size() + value.size() > std::numeric_limits<uint32_t>::max())
+        throw YoutubedlFrontendException("The comments of a video are larger than 4 GB");
+
+    strings->buffer.append(value);
+    strings->ends.push_back(static_cast<uint32_t>(strings->buffer.size()));
+    return static_cast<uint32_t>(strings->ends.size() - 1);
+}
+
+uint32_t YoutubeComments::Builder::intern(std::string_view value)
+{
+    // Keep the table at most half full
+    if (2 * (internedCount + 1) > table.size())
+    {
+        std::vector<uint32_t> old(table.size() * 2, 0);
+        old.swap(table);
+        for (uint32_t entry : old)
+        {
+            if (entry == 0)
+                continue;
+            size_t slot = std::hash<std::string_view>()(strings->get(entry - 1)) & (table.size() - 1);
+            while (table[slot] != 0)
+                slot = (slot + 1) & (table.size() - 1);
+            table[slot] = entry;
+        }
+    }
+
+    size_t slot = std::hash<std::string_view>()(value) & (table.size() - 1);
+    for (; table[slot] != 0; slot = (slot + 1) & (table.size() - 1))
+    {
+        if (strings->get(table[slot] - 1) == value)
+            return table[slot] - 1;
+    }
+
+    uint32_t index = append(value);
+    table[slot] = index + 1;
+    ++internedCount;
+    return index;
+}
+
+void YoutubeComments::Builder::add(
+    std::string_view id,
+    std::string_view parentId,
+    std::string_view text,
+    std::string_view author,
+    long timestamp
+) {
+    Record record{};
+    record.id = intern(id);
+    record.parentId = intern(parentId);
+    record.text = append(text);
+    record.author = intern(author);
+    record.timestamp = timestamp;
+    record.parent = NO_PARENT;
+    records.push_back(record);
+}
+
+void YoutubeComments::Builder::add(const YoutubeComment& comment)
+{
+    add(comment.id, comment.parentId, comment.text, comment.author, comment.timestamp);
+}
+
+void YoutubeComments::Builder::add(const Comment& comment)
+{
+    add(comment.id, comment.parentId, comment.text, comment.author, comment.timestamp);
+    Record& record = records.back();
+    record.depth = comment.depth;
+    record.parent = comment.parent;
+    record.replyCount = comment.replyCount;
+}
+
+YoutubeComments YoutubeComments::Builder::build()
+{
+    strings->buffer.shrink_to_fit();
+    strings->ends.shrink_to_fit();
+    records.shrink_to_fit();
+
+    uint64_t digest = computeDigest(*strings, records);
+    auto data = std::make_shared<Data>(Data{std::move(strings), std::move(records), digest});
+
+    strings = std::make_shared<Strings>();
+    records = {};
+    table.assign(64, 0);
+    internedCount = 0;
+
+    return YoutubeComments(std::move(data));
+}
+
+YoutubeComments YoutubeComments::getThreaded() const
+{
+    if (!data)
+        return *this;
+
+    const std::vector<Record>& records = data->records;
+    const Strings& strings = *data->strings;
+
+    // Ids are interned, so the children of a comment are the records whose
+    // parentId is the string index of its id. They are stored contiguously
+    // per parent string (compressed adjacency list).
+    std::vector<uint32_t> childrenStart(strings.ends.size() + 1, 0);
+    for (const Record& record : records)
+        ++childrenStart[record.parentId + 1];
+    std::partial_sum(childrenStart.begin(), childrenStart.end(), childrenStart.begin());
+
+    // Oldest first, equal timestamps keep the order of the list. The distribution
+    // below is stable, so one sort orders the children of every comment.
+    std::vector<uint32_t> byTimestamp(records.size());
+    std::iota(byTimestamp.begin(), byTimestamp.end(), 0);
+    std::stable_sort(byTimestamp.begin(), byTimestamp.end(),
+                     [&records](uint32_t a, uint32_t b) { return records[a].timestamp < records[b].timestamp; });
+
+    std::vector<uint32_t> children(records.size());
+    {
+        std::vector<uint32_t> next(childrenStart.begin(), childrenStart.end() - 1);
+        for (uint32_t i : byTimestamp)
+            children[next[records[i].parentId]++] = i;
+    }
+
+    std::vector<Record> threaded;
+    threaded.reserve(records.size());
+    std::vector<bool> visited(records.size(), false);
+
+    struct Pending {
+        uint32_t record;
+        uint32_t parent; // index in threaded
+        uint32_t depth;
+    };
+    std::vector<Pending> stack;
+
+    // Depth-first, children are pushed in reverse so the oldest is visited first.
+    // A comment is emitted only once, even if ids repeat.
+    auto pushChildren = [&](uint32_t parentString, uint32_t parent, uint32_t depth) {
+        for (uint32_t k = childrenStart[parentString + 1]; k > childrenStart[parentString]; --k)
+            stack.push_back(Pending{children[k - 1], parent, depth});
+    };
+
+    auto root = std::find_if(records.begin(), records.end(),
+                             [&strings](const Record& record) { return strings.get(record.parentId) == "root"; });
+    if (root != records.end())
+        pushChildren(root->parentId, NO_PARENT, 0);
+
+    while (!stack.empty())
+    {
+        Pending pending = stack.back();
+        stack.pop_back();
+        if (visited[pending.record])
+            continue;
+        visited[pending.record] = true;
+
+        Record record = records[pending.record];
+        record.depth = pending.depth;
+        record.parent = pending.parent;
+        record.replyCount = 0;
+        if (pending.parent != NO_PARENT)
+            ++threaded[pending.parent].replyCount;
+
+        uint32_t index = static_cast<uint32_t>(threaded.size());
+        threaded.push_back(record);
+        pushChildren(record.id, index, pending.depth + 1);
+    }
+
+    threaded.shrink_to_fit();
+    uint64_t digest = computeDigest(strings, threaded);
+    return YoutubeComments(std::make_shared<Data>(Data{data->strings, std::move(threaded), digest}));
+}
+
+size_t YoutubeComments::getMemoryUsage() const
+{
+    if (!data)
+        return 0;
+    return sizeof(Data) + sizeof(Strings)
+         + data->strings->buffer.capacity()
+         + data->strings->ends.capacity() * sizeof(uint32_t)
+         + data->records.capacity() * sizeof(Record);
+}
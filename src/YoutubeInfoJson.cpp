@@ -0,0 +1,268 @@
+/*
+ * MIT License
+ * Copyright (c) 2024-2025 Robert Vokac
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "YoutubeInfoJson.h"
+#include "MappedFile.h"
+#include "YoutubedlFrontendException.h"
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+
+// Collects the wanted fields and ignores everything else.
+// Unknown subtrees are skipped by counting their nesting only.
+class InfoJsonSax : public nlohmann::json_sax<json> {
+private:
+    enum class Context {
+        NONE,       // before the top level object
+        TOP,        // the top level object
+        THUMBNAILS, // "thumbnails" array
+        THUMBNAIL,  // object inside "thumbnails"
+        COMMENTS,   // "comments" array
+        COMMENT     // object inside "comments"
+    };
+
+    YoutubeInfoJson& info;
+    YoutubeComments::Builder comments;
+    YoutubeComment comment; // the one being read, its strings are reused
+    Context context = Context::NONE;
+    int skipDepth = 0;
+    std::string currentKey;
+
+    bool setString(const std::string& value) {
+        switch (context) {
+        case Context::TOP:
+            if (currentKey == "id") info.id = value;
+            else if (currentKey == "title") info.title = value;
+            else if (currentKey == "channel") info.channel = value;
+            else if (currentKey == "channel_url") info.channelUrl = value;
+            else if (currentKey == "channel_id") info.channelId = value;
+            else if (currentKey == "thumbnail") info.thumbnail = value;
+            else if (currentKey == "ext") info.ext = value;
+            else if (currentKey == "upload_date") info.uploadDate = value;
+            break;
+        case Context::THUMBNAIL:
+            if (currentKey == "url") info.thumbnails.back().url = value;
+            break;
+        case Context::COMMENT:
+            if (currentKey == "id") comment.id = value;
+            else if (currentKey == "parent") comment.parentId = value;
+            else if (currentKey == "text") comment.text = value;
+            else if (currentKey == "author") comment.author = value;
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool setNumber(long value) {
+        if (context == Context::TOP && currentKey == "timestamp")
+            info.timestamp = value;
+        else if (context == Context::THUMBNAIL && currentKey == "width")
+            info.thumbnails.back().width = static_cast<int>(value);
+        else if (context == Context::COMMENT && currentKey == "timestamp")
+            comment.timestamp = value;
+        return true;
+    }
+
+    bool startContainer(bool isObject) {
+        if (skipDepth > 0) {
+            ++skipDepth;
+            return true;
+        }
+
+        if (context == Context::NONE && isObject)
+            context = Context::TOP;
+        else if (context == Context::TOP && !isObject && currentKey == "thumbnails")
+            context = Context::THUMBNAILS;
+        else if (context == Context::TOP && !isObject && currentKey == "comments")
+            context = Context::COMMENTS;
+        else if (context == Context::THUMBNAILS && isObject) {
+            context = Context::THUMBNAIL;
+            info.thumbnails.emplace_back();
+        } else if (context == Context::COMMENTS && isObject) {
+            context = Context::COMMENT;
+            comment.id.clear();
+            comment.parentId.clear();
+            comment.text.clear();
+            comment.author.clear();
+            comment.timestamp = 0;
+        } else
+            skipDepth = 1;
+        return true;
+    }
+
+    bool endContainer() {
+        if (skipDepth > 0) {
+            --skipDepth;
+            return true;
+        }
+
+        switch (context) {
+        case Context::THUMBNAILS:
+        case Context::COMMENTS:
+            context = Context::TOP;
+            break;
+        case Context::THUMBNAIL:
+            context = Context::THUMBNAILS;
+            break;
+        case Context::COMMENT:
+            comments.add(comment);
+            context = Context::COMMENTS;
+            break;
+        default:
+            context = Context::NONE;
+            break;
+        }
+        return true;
+    }
+
+public:
+    explicit InfoJsonSax(YoutubeInfoJson& info) : info(info) {}
+
+    void finish() {
+        info.comments = comments.build();
+    }
+
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool number_float(number_float_t, const string_t&) override { return true; }
+    bool binary(binary_t&) override { return true; }
+
+    bool number_integer(number_integer_t val) override {
+        return skipDepth > 0 || setNumber(static_cast<long>(val));
+    }
+
+    bool number_unsigned(number_unsigned_t val) override {
+        return skipDepth > 0 || setNumber(static_cast<long>(val));
+    }
+
+    bool string(string_t& val) override {
+        return skipDepth > 0 || setString(val);
+    }
+
+    bool key(string_t& val) override {
+        if (skipDepth == 0)
+            currentKey = val;
+        return true;
+    }
+
+    bool start_object(std::size_t) override { return startContainer(true); }
+    bool end_object() override { return endContainer(); }
+    bool start_array(std::size_t) override { return startContainer(false); }
+    bool end_array() override { return endContainer(); }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        throw YoutubedlFrontendException("Cannot parse info JSON", ex);
+    }
+};
+
+// Stops the parser once the ids are found
+class IdsSax : public nlohmann::json_sax<json> {
+private:
+    bool needChannelId;
+    std::string& id;
+    std::string& channelId;
+    int depth = 0;
+    std::string currentKey;
+    bool idFound = false;
+    bool channelIdFound = false;
+
+public:
+    bool parseError = false;
+
+    IdsSax(bool needChannelId, std::string& id, std::string& channelId)
+        : needChannelId(needChannelId), id(id), channelId(channelId) {}
+
+    bool isComplete() const {
+        return idFound && (channelIdFound || !needChannelId);
+    }
+
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool number_integer(number_integer_t) override { return true; }
+    bool number_unsigned(number_unsigned_t) override { return true; }
+    bool number_float(number_float_t, const string_t&) override { return true; }
+    bool binary(binary_t&) override { return true; }
+
+    bool string(string_t& val) override {
+        if (depth == 1 && currentKey == "id") {
+            id = val;
+            idFound = true;
+        } else if (depth == 1 && currentKey == "channel_id") {
+            channelId = val;
+            channelIdFound = true;
+        }
+        return !isComplete();
+    }
+
+    bool key(string_t& val) override {
+        if (depth == 1)
+            currentKey = val;
+        return true;
+    }
+
+    bool start_object(std::size_t) override { ++depth; return true; }
+    bool end_object() override { --depth; return true; }
+    bool start_array(std::size_t) override { ++depth; return true; }
+    bool end_array() override { --depth; return true; }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+        parseError = true;
+        return false;
+    }
+};
+
+} // namespace
+
+YoutubeInfoJson YoutubeInfoJson::parse(std::string_view text)
+{
+    YoutubeInfoJson info;
+    InfoJsonSax sax(info);
+    json::sax_parse(text.begin(), text.end(), &sax);
+    sax.finish();
+    return info;
+}
+
+YoutubeInfoJson YoutubeInfoJson::load(const std::filesystem::path& file)
+{
+    MappedFile mappedFile(file);
+    return parse(mappedFile.view());
+}
+
+bool YoutubeInfoJson::scanIds(std::string_view text, bool needChannelId, std::string& id, std::string& channelId)
+{
+    IdsSax sax(needChannelId, id, channelId);
+    json::sax_parse(text.begin(), text.end(), &sax);
+    // A file without "channel_id" is read to the end, the id is enough then
+    return !sax.parseError && (sax.isComplete() || !id.empty());
+}
+
+bool YoutubeInfoJson::loadIds(const std::filesystem::path& file, bool needChannelId, std::string& id, std::string& channelId)
+{
+    MappedFile mappedFile(file);
+    return scanIds(mappedFile.view(), needChannelId, id, channelId);
+}
@@ -22,14 +22,25 @@
  */
 
 #include "YoutubeVideo.h"
+#include "YoutubeInfoJson.h"
+#include "MetadataCache.h"
+#include "ArchiveIndex.h"
+#include "BlockingQueue.h"
+#include "HashCache.h"
+#include "IoScheduler.h"
+#include "MediaProbe.h"
+#include "Progress.h"
+#include "TaskScheduler.h"
 #include "Utils.h"
 #include "YoutubedlFrontendException.h"
-#include <nlohmann/json.hpp>
 
-#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <sys/stat.h>
 
 #include "Constants.h"
 
@@ -37,7 +48,6 @@ extern "C" {
 #include <libavformat/avformat.h>
     }
 
-using json = nlohmann::json;
 namespace fs = std::filesystem;
 
 std::vector<std::string> YoutubeVideo::missingYoutubeVideos;
@@ -53,76 +63,30 @@ YoutubeVideo::YoutubeVideo()
 
 YoutubeVideo::YoutubeVideo(
     const fs::path& mediaDirectory,
-    bool alwaysGenerateMetadata,
-    const std::string& argVideo
+    bool alwaysGenerateMetadata
 ) : videoFileSizeInBytes(0),
     timestamp(0),
     number(0)
 {
-    fs::path metadataFile = mediaDirectory / "metadata";
+    fs::path metadataFile = mediaDirectory / MetadataCache::FILE_NAME;
 
     // ----------- CASE 1: Read from metadata file ----------
-    if (!alwaysGenerateMetadata && fs::exists(metadataFile))
+    if (!alwaysGenerateMetadata)
     {
-        std::ifstream ifs(metadataFile);
-        if (!ifs)
-            throw std::runtime_error("Cannot open metadata file");
-
-        std::map<std::string, std::string> props;
-        std::string line;
-        while (std::getline(ifs, line))
+        YoutubeVideo cached;
+        if (MetadataCache::read(metadataFile, cached))
         {
-            auto pos = line.find('=');
-            if (pos != std::string::npos)
-            {
-                props[line.substr(0, pos)] = line.substr(pos + 1);
-            }
-        }
-
-        id = props["id"];
-        if (!argVideo.empty() && id != argVideo)
+            *this = std::move(cached);
             return;
+        }
 
-        snapshot = props["snapshot"];
-        title = props["title"];
-        videoFileName = props["videoFileName"];
-        videoFileSizeInBytes = std::stoll(props["videoFileSizeInBytes"]);
-        videoFileSha512HashSum = props["videoFileSha512HashSum"];
-        videoDuration = props["videoDuration"];
-        channelName = props["channelName"];
-        channelUrl = props["channelUrl"];
-        channelId = props["channelId"];
-        uploadDate = props["uploadDate"];
-        timestamp = std::stoll(props["timestamp"]);
-        description = props["description"];
-        thumbnail = props["thumbnail"];
-        miniThumbnail = props["miniThumbnail"];
-
-        // Comments JSON
-        comments.clear();
-        if (props.count("comments"))
+        // One-way migration of the old text format
+        if (MetadataCache::readLegacy(mediaDirectory / MetadataCache::LEGACY_FILE_NAME, cached))
         {
-            try
-            {
-                json arr = json::parse(props["comments"]);
-                for (auto& elem : arr)
-                {
-                    YoutubeComment yc(elem);
-                    comments.push_back(yc);
-                }
-            }
-            catch (...)
-            {
-                throw std::runtime_error("Error parsing comments JSON");
-            }
+            *this = std::move(cached);
+            MetadataCache::write(metadataFile, *this);
+            return;
         }
-
-        previousVideoId = props.count("previousVideoId") ? props["previousVideoId"] : "";
-        nextVideoId = props.count("nextVideoId") ? props["nextVideoId"] : "";
-        ext = props["ext"];
-        number = std::stoi(props["number"]);
-
-        return;
     }
 
     // ----------- CASE 2: Parse mediaDirectory JSON + video info ----------
@@ -141,22 +105,22 @@ YoutubeVideo::YoutubeVideo(
         }
     }
 
-    std::string jsonTxt = jsonFile.empty() ? "" : Utils::readTextFromFile(jsonFile);
-    json jsonObject = json::parse(jsonTxt);
+    if (jsonFile.empty())
+        throw YoutubedlFrontendException("No info JSON file found in: " + mediaDirectory.string());
 
-    id = jsonObject.value("id", "");
+    YoutubeInfoJson info = YoutubeInfoJson::load(jsonFile);
 
-    thumbnail = jsonObject.value("thumbnail", "");
-    auto thumbnails = jsonObject["thumbnails"];
+    id = info.id;
 
-    for (auto& t : thumbnails)
+    thumbnail = info.thumbnail;
+
+    for (auto& t : info.thumbnails)
     {
-        if (t.contains("width"))
+        if (t.width >= 0)
         {
-            int width = t["width"];
-            if (width < static_cast<int>(THUMBNAIL_WIDTH * 0.8))
+            if (t.width < static_cast<int>(THUMBNAIL_WIDTH * 0.8))
                 continue;
-            miniThumbnail = t["url"];
+            miniThumbnail = t.url;
             break;
         }
     }
@@ -178,7 +142,7 @@ YoutubeVideo::YoutubeVideo(
     }
 
     // Find video file (mp4, mkv, webm)
-    ext = jsonObject.value("ext", "");
+    ext = info.ext;
     fs::path videoFile;
     for (auto& f : files)
     {
@@ -195,8 +159,7 @@ YoutubeVideo::YoutubeVideo(
 
     snapshot = mediaDirectory.parent_path().filename().string();
 
-    if (videoFile.empty())
-        missingYoutubeVideos.push_back(id);
+    videoFileMissing = videoFile.empty();
 
     // Read .description if present
     fs::path descriptionFile;
@@ -212,69 +175,39 @@ YoutubeVideo::YoutubeVideo(
                       ? ""
                       : Utils::readTextFromFile(descriptionFile);
 
-    title = jsonObject.value("title", "");
+    title = info.title;
 
     if (!videoFile.empty() && !videoFile.filename().string().ends_with(".part"))
-    {
         videoFileName = videoFile.filename().string();
-        videoFileSizeInBytes = fs::file_size(videoFile);
-        videoFileSha512HashSum = Utils::calculateSHA512Hash(videoFile);
-        videoDuration = getVideoFormattedDuration(videoFile.string());
-    }
 
-    channelName = jsonObject.value("channel", "");
-    channelUrl = jsonObject.value("channel_url", "");
-    channelId = jsonObject.value("channel_id", "");
-    uploadDate = jsonObject.value("upload_date", "");
-    timestamp = jsonObject.value("timestamp", 0L);
+    channelName = info.channel;
+    channelUrl = info.channelUrl;
+    channelId = info.channelId;
+    uploadDate = info.uploadDate;
+    timestamp = info.timestamp;
 
-    // Load comments
-    comments.clear();
-    if (jsonObject.contains("comments"))
-    {
-        for (auto& elem : jsonObject["comments"])
-        {
-            comments.emplace_back(elem);
-        }
-    }
-    comments = YoutubeComment::sort(comments);
-
-    std::ofstream ofs(metadataFile);
-    ofs << "id=" << id << "\n";
-    ofs << "snapshot=" << snapshot << "\n";
-    ofs << "title=" << title << "\n";
-    ofs << "videoFileName=" << videoFileName << "\n";
-    ofs << "videoFileSizeInBytes=" << videoFileSizeInBytes << "\n";
-    ofs << "videoFileSha512HashSum=" << videoFileSha512HashSum << "\n";
-    ofs << "videoDuration=" << videoDuration << "\n";
-    ofs << "channelName=" << channelName << "\n";
-    ofs << "channelUrl=" << channelUrl << "\n";
-    ofs << "channelId=" << channelId << "\n";
-    ofs << "uploadDate=" << uploadDate << "\n";
-    ofs << "timestamp=" << timestamp << "\n";
-    ofs << "description=" << description << "\n";
-    ofs << "thumbnail=" << thumbnail << "\n";
-    ofs << "miniThumbnail=" << miniThumbnail << "\n";
+    comments = info.comments.getThreaded();
 
-    {
-        std::vector<nlohmann::json> comments_json;
-        for (auto& comment : comments)
-        {
-            nlohmann::json comment_json = comment.to_json();
-            comments_json.emplace_back(comment_json);
-        }
+    videoFileAnalysisPending = true;
+}
 
-        json jComments = comments_json;
-        ofs << "comments=" << jComments.dump() << "\n";
+uint64_t YoutubeVideo::analyzeVideoFile(const fs::path& mediaDirectory, HashCache& hashCache)
+{
+    uint64_t bytesRead = 0;
+    if (!videoFileName.empty())
+    {
+        fs::path videoFile = mediaDirectory / videoFileName;
+        videoFileSizeInBytes = fs::file_size(videoFile);
+        bool hashed = false;
+        videoFileSha512HashSum = hashCache.getSha512Hash(videoFile, &hashed);
+        if (hashed)
+            bytesRead += videoFileSizeInBytes;
+        videoDuration = getVideoFormattedDuration(videoFile.string());
     }
 
-    if (!previousVideoId.empty())
-        ofs << "previousVideoId=" << previousVideoId << "\n";
-    if (!nextVideoId.empty())
-        ofs << "nextVideoId=" << nextVideoId << "\n";
-
-    ofs << "ext=" << ext << "\n";
-    ofs << "number=" << number << "\n";
+    MetadataCache::write(mediaDirectory / MetadataCache::FILE_NAME, *this);
+    videoFileAnalysisPending = false;
+    return bytesRead;
 }
 
 long YoutubeVideo::getVideoDurationInMilliseconds() const
@@ -345,22 +278,11 @@ std::string YoutubeVideo::formatTimeStamp(long duration)
 
 std::string YoutubeVideo::getVideoFormattedDuration(const std::string& filePath)
 {
-    avformat_network_init();
-    AVFormatContext* fmtCtx = nullptr;
-
-    if (avformat_open_input(&fmtCtx, filePath.c_str(), nullptr, nullptr) < 0)
-        return "00:00:00.00";
-
-    if (avformat_find_stream_info(fmtCtx, nullptr) < 0)
-    {
-        avformat_close_input(&fmtCtx);
+    std::optional<int64_t> duration = MediaProbe::getDuration(filePath);
+    if (!duration)
         return "00:00:00.00";
-    }
-
-    long duration = fmtCtx->duration; // AV_TIME_BASE units
-    avformat_close_input(&fmtCtx);
 
-    return formatTimeStamp(duration);
+    return formatTimeStamp(*duration);
 }
 
 // YoutubeVideo.cpp
@@ -375,111 +297,193 @@ bool YoutubeVideo::operator<(const YoutubeVideo& o) const
         return timestamp < o.timestamp;
     }
 
-    return false;
+    // Videos without channel go first, so every channel stays contiguous
+    return !aHas && bHas;
 }
 
-#include <future>
-#include <queue>
-#include <condition_variable>
-#include <mutex>
-
-class ThreadPool {
-    std::vector<std::thread> workers;
-    std::queue<std::function<void()>> tasks;
-
-    std::mutex queueMutex;
-    std::condition_variable condition;
-    bool stop = false;
-
-public:
-    explicit ThreadPool(size_t threads) {
-        for (size_t i = 0; i < threads; ++i) {
-            workers.emplace_back([this] {
-                for (;;) {
-                    std::function<void()> task;
-                    {
-                        std::unique_lock<std::mutex> lock(this->queueMutex);
-                        this->condition.wait(lock, [this] {
-                            return this->stop || !this->tasks.empty();
-                        });
-                        if (this->stop && this->tasks.empty())
-                            return;
-                        task = std::move(this->tasks.front());
-                        this->tasks.pop();
-                    }
-                    task();
-                }
-            });
-        }
+// In --verify-hashes mode the video file is hashed again and compared with the metadata
+static uint64_t verifyVideoFileHash(const YoutubeVideo& v, const fs::path& mediaDir, HashCache& hashCache)
+{
+    fs::path videoFile = mediaDir / v.videoFileName;
+    if (!fs::exists(videoFile))
+        return 0;
+
+    bool hashed = false;
+    std::string hash = hashCache.getSha512Hash(videoFile, &hashed);
+    if (hash != v.videoFileSha512HashSum)
+        hashCache.reportMismatch(videoFile.string() + ": metadata " + v.videoFileSha512HashSum + ", now " + hash);
+    return hashed ? static_cast<uint64_t>(v.videoFileSizeInBytes) : 0;
+}
+
+// --video and --channel, applied before a snapshot is loaded, so the snapshots
+// which do not match are not parsed, hashed, probed or given thumbnails
+struct VideoFilter {
+    std::string videoId;
+    std::string channelId;
+
+    bool isEmpty() const {
+        return videoId.empty() && channelId.empty();
     }
 
-    template<class F>
-    auto enqueue(F f) -> std::future<decltype(f())> {
-        auto taskPtr =
-            std::make_shared<std::packaged_task<decltype(f())()>>(std::move(f));
-        std::future<decltype(f())> res = taskPtr->get_future();
-        {
-            std::lock_guard<std::mutex> lock(queueMutex);
-            tasks.emplace([taskPtr] { (*taskPtr)(); });
-        }
-        condition.notify_one();
-        return res;
+    bool matches(const std::string& id, const std::string& channel) const {
+        return (videoId.empty() || id == videoId) && (channelId.empty() || channel == channelId);
     }
 
-    ~ThreadPool() {
-        {
-            std::lock_guard<std::mutex> lock(queueMutex);
-            stop = true;
+    // Reads only the ids: from the archive index record, the metadata file or
+    // the beginning of the info JSON. A snapshot whose ids cannot be read
+    // that way is loaded, its errors are reported as before.
+    bool mayMatch(const std::optional<std::string_view>& record, const fs::path& mediaDir, bool alwaysMetadata) const {
+        if (isEmpty())
+            return true;
+
+        std::string id;
+        std::string channel;
+        if (record && MetadataCache::deserializeIds(*record, id, channel))
+            return matches(id, channel);
+        if (!alwaysMetadata && MetadataCache::readIds(mediaDir / MetadataCache::FILE_NAME, id, channel))
+            return matches(id, channel);
+
+        std::error_code ec;
+        for (auto& entry : fs::directory_iterator(mediaDir, ec)) {
+            if (entry.path().extension() != ".json")
+                continue;
+            try {
+                if (YoutubeInfoJson::loadIds(entry.path(), !channelId.empty(), id, channel))
+                    return matches(id, channel);
+            } catch (const YoutubedlFrontendException&) {}
+            break; // the constructor takes the first JSON file too
         }
-        condition.notify_all();
-        for (auto &t : workers)
-            t.join();
+        return true;
     }
 };
 
+// Snapshot loaded from its media directory, it gets a new archive index record
+struct SnapshotToIndex {
+    std::string snapshot;
+    fs::path mediaDir;
+};
 
-std::vector<YoutubeVideo> YoutubeVideo::loadYoutubeVideos(
-    const fs::path& archiveBoxArchiveDirectory,
-    const Args& argsInstance
-) {
-    std::vector<std::future<YoutubeVideo>> futures;
+// A snapshot whose loading has finished, in the order of completion
+struct LoadedSnapshot {
+    YoutubeVideo video;
+    std::exception_ptr error;
+    std::optional<SnapshotToIndex> toIndex;
+    bool filteredOut = false;
+};
 
-    bool alwaysMetadata = argsInstance.getBool(ArgType::ALWAYS_GENERATE_METADATA);
-    std::string argVideo = argsInstance.getString(ArgType::VIDEO).value_or("");
-    std::string argChannelId = argsInstance.getString(ArgType::CHANNEL).value_or("");
+using LoadedSnapshots = BlockingQueue<LoadedSnapshot>;
+
+// Called on a worker once the CPU part of loading is done. Reading the video file
+// is handed over to the I/O scheduler of its device, so the worker is free again.
+static void completeVideo(
+    YoutubeVideo v,
+    const fs::path& mediaDir,
+    std::optional<SnapshotToIndex> toIndex,
+    HashCache& hashCache,
+    IoScheduler& ioScheduler,
+    LoadedSnapshots& loaded
+) {
+    if (v.videoFileName.empty() || (!v.videoFileAnalysisPending && !hashCache.isVerifying()))
+    {
+        // Nothing to read, only the metadata file is written
+        if (v.videoFileAnalysisPending)
+            v.analyzeVideoFile(mediaDir, hashCache);
+        loaded.push(LoadedSnapshot{std::move(v), nullptr, std::move(toIndex)});
+        return;
+    }
 
-    size_t threadCount = std::max(2u, std::thread::hardware_concurrency());
-    ThreadPool pool(threadCount);
+    struct stat st {};
+    if (::stat((mediaDir / v.videoFileName).c_str(), &st) != 0)
+        st.st_dev = 0;
+
+    ioScheduler.submit(st.st_dev, [v = std::move(v), mediaDir, toIndex = std::move(toIndex),
+                                   &hashCache, &loaded]() mutable -> uint64_t {
+        uint64_t bytesRead = 0;
+        try {
+            if (v.videoFileAnalysisPending)
+                bytesRead += v.analyzeVideoFile(mediaDir, hashCache);
+            else
+                bytesRead += verifyVideoFileHash(v, mediaDir, hashCache);
+            loaded.push(LoadedSnapshot{std::move(v), nullptr, std::move(toIndex)});
+        } catch (...) {
+            loaded.push(LoadedSnapshot{YoutubeVideo(), std::current_exception(), std::nullopt});
+        }
+        return bytesRead;
+    });
+}
 
-    // ✅ Iterate directories
-    for (auto &entry : fs::directory_iterator(archiveBoxArchiveDirectory)) {
-        const fs::path snapshotDir = entry.path();
-        fs::path mediaDir = snapshotDir / "media";
-        if (!fs::exists(mediaDir))
-            continue;
+std::vector<YoutubeVideo> YoutubeVideo::loadYoutubeVideos(
+    const fs::path& archiveBoxArchiveDirectory,
+    const Config& config,
+    TaskScheduler& scheduler
+) {
+    bool alwaysMetadata = config.alwaysGenerateMetadata;
+    VideoFilter filter {config.video, config.channel};
+
+    fs::path stateDirectory = archiveBoxArchiveDirectory.parent_path() / STATE_DIRECTORY_NAME;
+    HashCache hashCache(stateDirectory / HashCache::FILE_NAME, "video files",
+                        config.verifyHashes);
+
+    std::unique_ptr<ArchiveIndex> archiveIndex;
+    if (config.archiveIndex)
+        archiveIndex = std::make_unique<ArchiveIndex>(stateDirectory / ArchiveIndex::FILE_NAME);
+
+    // Finished snapshots are consumed in the order of completion, so a slow
+    // one does not hold back the others. At most maxInFlight snapshots are
+    // loading or waiting to be consumed, which bounds the memory.
+    LoadedSnapshots loaded;
+    const size_t maxInFlight = std::max<size_t>(256, 16 * scheduler.getThreadCount());
+    size_t inFlight = 0;
+    std::exception_ptr error;
+
+    // Its destructor waits for the I/O jobs, which run on the same scheduler
+    IoScheduler ioScheduler(scheduler, static_cast<size_t>(config.ioConcurrency));
+
+    // The tasks in flight refer to this frame. Whatever leaves it, an exception
+    // of the directory walk or of consume() too, first waits for all of them.
+    struct DrainInFlight {
+        LoadedSnapshots& loaded;
+        size_t& inFlight;
+        ~DrainInFlight() {
+            for (; inFlight > 0; --inFlight)
+                loaded.pop();
+        }
+    } drainInFlight {loaded, inFlight};
 
-        futures.push_back(
-            pool.enqueue([mediaDir, alwaysMetadata, argVideo] {
-                return YoutubeVideo(mediaDir, alwaysMetadata, argVideo);
-            })
-        );
-    }
+    // Counted once by names only, corrected when the walk below skipped entries
+    size_t entryCount = 0;
+    for (auto it = fs::directory_iterator(archiveBoxArchiveDirectory); it != fs::directory_iterator(); ++it)
+        ++entryCount;
+    Progress progress("Loading", "snapshots", entryCount, std::cerr, config.statusFile);
 
-    // ✅ Collect results
     std::vector<YoutubeVideo> videos;
-    videos.reserve(futures.size());
-
     int index = 0;
-    size_t archiveCount = futures.size();
 
-    for (auto &f : futures) {
-        YoutubeVideo v = f.get();
+    auto consume = [&] {
+        LoadedSnapshot result = loaded.pop();
+        --inFlight;
+        progress.advance();
+        if (result.filteredOut)
+            return;
+        if (result.error) {
+            // The snapshots in flight are still drained, they refer to this frame
+            if (!error)
+                error = result.error;
+            return;
+        }
+        YoutubeVideo& v = result.video;
+
+        // The mtime is taken after the metadata file was written into the directory
+        struct stat st {};
+        if (result.toIndex && ::stat(result.toIndex->mediaDir.c_str(), &st) == 0)
+            archiveIndex->add(result.toIndex->snapshot, ArchiveIndex::getMtime(st), v);
 
-        // filtering must happen AFTER loading
-        if (!argVideo.empty() && v.id != argVideo)
-            continue;
-        if (!argChannelId.empty() && v.channelId != argChannelId)
-            continue;
+        if (v.videoFileMissing)
+            missingYoutubeVideos.push_back(v.id);
+
+        // Snapshots which were loaded because their ids could not be read cheaply
+        if (!filter.matches(v.id, v.channelId))
+            return;
 
         ++index;
         std::cout << "\n\nFound video #" << index << "\n";
@@ -495,9 +499,86 @@ std::vector<YoutubeVideo> YoutubeVideo::loadYoutubeVideos(
         totalDurationInMilliseconds += v.getVideoDurationInMilliseconds();
 
         videos.push_back(std::move(v));
+    };
+
+    // Every snapshot is finished by either a CPU task or an I/O job
+    auto load = [&](auto&& makeVideo, std::optional<std::string_view> record,
+                    const fs::path& mediaDir, std::optional<SnapshotToIndex> toIndex) {
+        while (inFlight >= maxInFlight)
+            consume();
+        ++inFlight;
+        scheduler.submit([makeVideo = std::move(makeVideo), record, mediaDir, toIndex = std::move(toIndex),
+                          alwaysMetadata, &filter, &hashCache, &ioScheduler, &loaded]() mutable {
+            try {
+                if (!filter.mayMatch(record, mediaDir, alwaysMetadata)) {
+                    loaded.push(LoadedSnapshot{YoutubeVideo(), nullptr, std::nullopt, true});
+                    return;
+                }
+                YoutubeVideo video = makeVideo(toIndex);
+                completeVideo(std::move(video), mediaDir, std::move(toIndex), hashCache, ioScheduler, loaded);
+            } catch (...) {
+                loaded.push(LoadedSnapshot{YoutubeVideo(), std::current_exception(), std::nullopt});
+            }
+        });
+    };
+
+    // ✅ Iterate directories
+    for (auto &entry : fs::directory_iterator(archiveBoxArchiveDirectory)) {
+        if (error)
+            break;
+
+        const fs::path snapshotDir = entry.path();
+        fs::path mediaDir = snapshotDir / "media";
+        struct stat st {};
+        if (::stat(mediaDir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode))
+            continue;
+
+        std::string snapshot = snapshotDir.filename().string();
+        std::optional<std::string_view> record;
+        if (archiveIndex && !alwaysMetadata)
+            record = archiveIndex->find(snapshot, ArchiveIndex::getMtime(st));
+
+        if (record) {
+            load([record = *record, snapshot, mediaDir, alwaysMetadata](std::optional<SnapshotToIndex>& toIndex) {
+                YoutubeVideo v;
+                try {
+                    if (MetadataCache::deserialize(record, v))
+                        return v;
+                } catch (const YoutubedlFrontendException&) {}
+                // The fresh result replaces the damaged record
+                toIndex = SnapshotToIndex{snapshot, mediaDir};
+                return YoutubeVideo(mediaDir, alwaysMetadata);
+            }, record, mediaDir, std::nullopt);
+            continue;
+        }
+
+        std::optional<SnapshotToIndex> toIndex;
+        if (archiveIndex)
+            toIndex = SnapshotToIndex{snapshot, mediaDir};
+        load([mediaDir, alwaysMetadata](std::optional<SnapshotToIndex>&) {
+            return YoutubeVideo(mediaDir, alwaysMetadata);
+        }, std::nullopt, mediaDir, std::move(toIndex));
     }
 
-    // ✅ Must preserve original global sorting
+    // ✅ Collect the rest
+    progress.setTotal(progress.getDone() + inFlight);
+    while (inFlight > 0)
+        consume();
+    progress.finish();
+    if (error)
+        std::rethrow_exception(error);
+
+    if (archiveIndex)
+        archiveIndex->save();
+    // Every video file was looked up when all snapshots were analyzed or verified
+    hashCache.save(filter.isEmpty() && (alwaysMetadata || hashCache.isVerifying()));
+
+    ioScheduler.printStatistics(std::cout);
+
+    if (hashCache.isVerifying())
+        std::cout << "Hash verification: " << hashCache.getMismatches().size() << " mismatches\n";
+
+    // ✅ Must preserve original global sorting, done once for all videos
     std::sort(videos.begin(), videos.end());
 
     // ✅ Set previous/next
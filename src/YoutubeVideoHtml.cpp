@@ -22,9 +22,11 @@
  */
 
 #include "YoutubeVideoHtml.h"
+#include "PageTemplates.h"
 #include "Utils.h"
-#include <sstream>
-#include <iomanip>
+#include <algorithm>
+#include <cctype>
+#include <utility>
 #include <chrono>
 #include <ctime>
 
@@ -72,165 +74,176 @@ static std::string escapeForShell(const std::string& input) {
 }
 
 static std::string urlEncode(const std::string& value) {
-    std::ostringstream escaped;
-    escaped.fill('0');
-    escaped << hex << uppercase;
+    static constexpr char HEX[] = "0123456789ABCDEF";
+    std::string escaped;
+    escaped.reserve(value.size());
 
     for (unsigned char c : value) {
         // Safe characters remain the same
         if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
-            escaped << c;
+            escaped += static_cast<char>(c);
         } else {
-            escaped << '%' << setw(2) << int(c);
+            escaped += '%';
+            escaped += HEX[c >> 4];
+            escaped += HEX[c & 15];
         }
     }
-    return escaped.str();
+    return escaped;
+}
+
+static void appendComment(HtmlBuffer& out, const YoutubeComments::Comment& co) {
+    // Convert timestamp → formatted date
+    auto tp = std::chrono::system_clock::time_point(std::chrono::seconds(co.timestamp));
+    std::time_t t = std::chrono::system_clock::to_time_t(tp);
+    std::tm tm {};
+    localtime_r(&t, &tm); // std::localtime() checks the time zone file on every call
+
+    char buf[64];
+    size_t dateLength = std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm);
+
+    PageTemplates::Comment::render(out,
+        html::arg<"indent">(co.depth * 50),
+        html::arg<"author">(co.author),
+        html::arg<"date">(std::string_view(buf, dateLength)),
+        html::arg<"id">(co.id),
+        html::arg<"parentId">(co.parentId),
+        html::arg<"text">(co.text));
+}
+
+static void appendLoadMoreLink(HtmlBuffer& out, const std::string& href) {
+    PageTemplates::LoadMoreComments::render(out, html::arg<"href">(href));
 }
 
 YoutubeVideoHtml::YoutubeVideoHtml(
     const YoutubeVideo& youtubeVideo,
     const fs::path& archiveBoxRootDirectory,
     const fs::path& archiveBoxArchiveDirectory,
-    long countOfVideosInChannel
-) {
-    std::ostringstream html;
-
-    html << R"(<!DOCTYPE html>
-<html>
-<head>
-<meta charset="UTF-8">
-<link rel="icon" type="image/x-icon" href="../favicon.ico" sizes="16x16">
-<title>)"
-         << youtubeVideo.title
-         << R"(</title>
-<style>
-body {padding:20px;}
-* { font-family:Arial; }
-</style>
-</head>
-<body>
-)";
+    long countOfVideosInChannel,
+    const CommentPaging& commentPaging
+) : page(HtmlBuffer::acquire()) {
+    using namespace PageTemplates;
+    HtmlBuffer& out = *page;
 
-    std::string finalUrl = "https://www.youtube.com/watch?v=" + youtubeVideo.id;
-
-    html << "<input type=\"text\" id=\"youtube_url\" name=\"youtube_url\" size=\"60\" width=\"60\" "
-         << "style=\"margint-bottom:20px;margin-right:10px;font-size:110%;padding:5px;\" "
-         << "value=\"" << finalUrl << "\"><br><br>\n";
+    VideoPageHead::render(out,
+        html::arg<"favicon">("../favicon.ico"),
+        html::arg<"title">(youtubeVideo.title),
+        html::arg<"script">(""));
 
-    html << "<a target=\"_blank\" href=\"" << finalUrl << "\">"
-         << finalUrl << "</a><br>\n";
+    std::string finalUrl = "https://www.youtube.com/watch?v=" + youtubeVideo.id;
+    VideoUrl::render(out, html::arg<"url">(finalUrl));
 
     // URL-encode local filename
     std::string encodedFile = urlEncode(youtubeVideo.videoFileName);
-    std::string videoLocalUrl =
-        "file:///" +
-        (archiveBoxRootDirectory / "archive" / youtubeVideo.snapshot / "media" / encodedFile).string();
+    fs::path mediaDirectory = archiveBoxArchiveDirectory / youtubeVideo.snapshot / "media";
 
     // If not MKV, embed HTML5 video
     if (!youtubeVideo.videoFileName.ends_with(".mkv")) {
-        html << "<video src=\"../archive/" << youtubeVideo.snapshot
-             << "/media/" << encodedFile
-             << "\" controls height=\"440px\">"
-             << "Your browser does not support the video tag."
-             << "</video><br>\n";
+        VideoPlayer::render(out,
+            html::arg<"snapshot">(youtubeVideo.snapshot),
+            html::arg<"file">(encodedFile));
     } else {
-        html << "<a target=\"_blank\" href=\"" << videoLocalUrl << "\">"
-             << "<img style=\"margin:10px;height:500px;\" src=\"../archive/"
-             << youtubeVideo.snapshot
-             << "/media/thumbnail."
-             << youtubeVideo.getThumbnailFormat()
-             << "\"></a><br>\n";
+        std::string videoLocalUrl =
+            "file:///" +
+            (archiveBoxRootDirectory / "archive" / youtubeVideo.snapshot / "media" / encodedFile).string();
+        VideoThumbnail::render(out,
+            html::arg<"localUrl">(videoLocalUrl),
+            html::arg<"snapshot">(youtubeVideo.snapshot),
+            html::arg<"thumbnailFormat">(youtubeVideo.getThumbnailFormat()));
     }
 
-    html << "<span style=\"font-size:200%;font-weight:bold;\">"
-         << youtubeVideo.title << "</span><br><br>\n";
-
-    html << "#" << youtubeVideo.number << "&nbsp;&nbsp;&nbsp;";
-
     bool backEnabled =
         youtubeVideo.number > 1 && !youtubeVideo.previousVideoId.empty();
-
-    html << "<button "
-         << (backEnabled ? "" : "disabled")
-         << " style=\""
-         << (backEnabled ? "" : "visibility:hidden;")
-         << "font-size:200%;\" onclick=\"window.location ='./"
-         << youtubeVideo.previousVideoId << ".html'\">Back</button>";
-
-    html << "&nbsp;&nbsp;&nbsp;";
-
     bool nextEnabled =
         youtubeVideo.number < countOfVideosInChannel &&
         !youtubeVideo.nextVideoId.empty();
 
-    html << "<button "
-         << (nextEnabled ? "" : "disabled")
-         << " style=\""
-         << (nextEnabled ? "" : "visibility:hidden;")
-         << "font-size:200%;\" onclick=\"window.location ='./"
-         << youtubeVideo.nextVideoId << ".html'\">Next</button> ";
-
-    html << "<br><br><a href=\"../archive/"
-         << youtubeVideo.snapshot << "/media/" << encodedFile
-         << "\">Download</a> ";
-
     double mb = (double)youtubeVideo.videoFileSizeInBytes / 1024.0 / 1024.0;
-    html << std::fixed << std::setprecision(2) << mb << " MB ";
+
+    VideoNavigation::render(out,
+        html::arg<"title">(youtubeVideo.title),
+        html::arg<"number">(youtubeVideo.number),
+        html::arg<"backDisabled">(backEnabled ? "" : "disabled"),
+        html::arg<"backHidden">(backEnabled ? "" : "visibility:hidden;"),
+        html::arg<"previousId">(youtubeVideo.previousVideoId),
+        html::arg<"nextDisabled">(nextEnabled ? "" : "disabled"),
+        html::arg<"nextHidden">(nextEnabled ? "" : "visibility:hidden;"),
+        html::arg<"nextId">(youtubeVideo.nextVideoId),
+        html::arg<"snapshot">(youtubeVideo.snapshot),
+        html::arg<"file">(encodedFile),
+        html::arg<"sizeInMegaBytes">(html::Fixed{mb, 2}));
 
     if (youtubeVideo.videoFileName.ends_with(".mkv")) {
-        std::string v = youtubeVideo.videoFileName;
-        std::string vEsc = escapeForShell(v);
+        std::string vEsc = escapeForShell(youtubeVideo.videoFileName);
         std::string vWebm = vEsc.substr(0, vEsc.size() - 3) + "webm";
 
-        html << "<input type=\"text\" size=\"100\" style=\"margin-bottom:20px;margin-right:10px;"
-             << "font-size:110%;padding:5px;\" value=\"";
-        html << "cd " << (archiveBoxArchiveDirectory / youtubeVideo.snapshot / "media").string()
-             << " && ffmpeg -i " << vEsc << " -preset slow -crf 18 " << vWebm;
-        html << "\"><br>";
+        VideoConvertCommand::render(out,
+            html::arg<"mediaDirectory">(mediaDirectory.string()),
+            html::arg<"file">(vEsc),
+            html::arg<"webmFile">(vWebm));
     } else {
-        html << "<input type=\"text\" size=\"100\" style=\"margin-bottom:20px;margin-right:10px;"
-             << "font-size:110%;padding:5px;\" value=\"";
-        html << (archiveBoxArchiveDirectory / youtubeVideo.snapshot / "media").string();
-        html << "\"><br>";
+        VideoMediaDirectory::render(out, html::arg<"mediaDirectory">(mediaDirectory.string()));
     }
 
-    html << "<br><br><br>\n";
-
-    // Description
-    html << "<pre style=\"white-space: pre-wrap; border:1px solid black;max-width:600px;"
-         << "padding:10px;min-height:50px;\">";
-    if (youtubeVideo.description.empty())
-        html << "No description";
-    else
-        html << youtubeVideo.description;
-    html << "</pre>";
-
-    // Comments
-    html << "<h2>Comments</h2>";
-
-    for (const auto& co : youtubeVideo.comments) {
-        html << "<div style=\"margin-left:" << (co.dotCount() * 50) << "px;\">";
-        html << "<h3>" << co.author << "</h3>";
-
-        // Convert timestamp → formatted date
-        auto tp = std::chrono::system_clock::time_point(std::chrono::seconds(co.timestamp));
-        std::time_t t = std::chrono::system_clock::to_time_t(tp);
-        std::tm tm = *std::localtime(&t);
-
-        char buf[64];
-        std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm);
-
-        html << "<span style=\"color:grey;font-size:80%;\">" << buf << "</span><br>\n";
-        html << "<span style=\"color:grey;font-size:80%;\">" << co.id << " " << co.parentId << "</span><br>\n";
-
-        html << "<pre style=\"white-space: pre-wrap;border:1px solid black;"
-             << "max-width:600px;padding:10px;min-height:50px;\">"
-             << co.text << "</pre>";
+    VideoDescription::render(out,
+        html::arg<"description">(youtubeVideo.description.empty()
+                                 ? std::string_view("No description")
+                                 : std::string_view(youtubeVideo.description)));
+
+    // Index of the first comment of every top level thread
+    const YoutubeComments& comments = youtubeVideo.comments;
+    std::vector<size_t> threads;
+    if (commentPaging.threadsPerPage > 0) {
+        for (size_t i = 0; i < comments.size(); ++i) {
+            if (comments[i].depth == 0)
+                threads.push_back(i);
+        }
+    }
 
-        html << "</div>";
+    size_t firstPageThreads = threads.size();
+    size_t shardThreads = 0;
+    if (commentPaging.threadsPerPage > 0 && threads.size() > commentPaging.threadsPerPage) {
+        firstPageThreads = commentPaging.threadsPerPage;
+        size_t rest = threads.size() - firstPageThreads;
+        size_t maxShards = std::max<size_t>(1, commentPaging.maxShards);
+        shardThreads = std::max(commentPaging.threadsPerPage, (rest + maxShards - 1) / maxShards);
     }
 
-    html << "</body></html>";
+    // Comments [begin, end) of the threads [firstThread, firstThread + count)
+    auto threadRange = [&](size_t firstThread, size_t count) {
+        size_t begin = firstThread < threads.size() ? threads[firstThread] : comments.size();
+        size_t last = firstThread + count;
+        size_t end = last < threads.size() ? threads[last] : comments.size();
+        return std::make_pair(begin, end);
+    };
+
+    size_t firstPageEnd = shardThreads > 0 ? threadRange(0, firstPageThreads).second : comments.size();
+    for (size_t i = 0; i < firstPageEnd; ++i)
+        appendComment(out, comments[i]);
+
+    if (shardThreads > 0) {
+        appendLoadMoreLink(out, youtubeVideo.id + "/comments-1.html");
+        out << COMMENTS_SCRIPT;
+
+        for (size_t thread = firstPageThreads; thread < threads.size(); thread += shardThreads) {
+            auto [begin, end] = threadRange(thread, shardThreads);
+
+            HtmlBuffer::Pooled shardPage = HtmlBuffer::acquire();
+            HtmlBuffer& shard = *shardPage;
+            VideoPageHead::render(shard,
+                html::arg<"favicon">("../../favicon.ico"),
+                html::arg<"title">(youtubeVideo.title),
+                html::arg<"script">(COMMENTS_SCRIPT));
+            CommentShardBegin::render(shard, html::arg<"videoId">(youtubeVideo.id));
+
+            for (size_t i = begin; i < end; ++i)
+                appendComment(shard, comments[i]);
+            if (thread + shardThreads < threads.size())
+                appendLoadMoreLink(shard, "comments-" + std::to_string(commentShards.size() + 2) + ".html");
+
+            CommentShardEnd::render(shard);
+            commentShards.push_back(std::move(shardPage));
+        }
+    }
 
-    singleVideo = html.str();
+    VideoPageEnd::render(out);
 }
@@ -0,0 +1,44 @@
+# Runs youtube_frontend on a copy of the golden archive and compares every
+# generated page with the expected one. The expected pages contain @ROOT@
+# where the program writes the absolute path of the archive.
+
+file(REMOVE_RECURSE ${WORK_DIRECTORY})
+file(MAKE_DIRECTORY ${WORK_DIRECTORY})
+file(COPY ${ARCHIVE_DIRECTORY} DESTINATION ${WORK_DIRECTORY})
+
+execute_process(
+        COMMAND ${YOUTUBE_FRONTEND} ${WORK_DIRECTORY}
+        WORKING_DIRECTORY ${WORK_DIRECTORY}
+        RESULT_VARIABLE result
+        OUTPUT_VARIABLE output
+        ERROR_VARIABLE output
+)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "youtube_frontend failed with ${result}:\n${output}")
+endif ()
+
+file(GLOB_RECURSE expectedPages RELATIVE ${EXPECTED_DIRECTORY} ${EXPECTED_DIRECTORY}/*.html)
+file(GLOB_RECURSE generatedPages RELATIVE ${WORK_DIRECTORY}
+        ${WORK_DIRECTORY}/videos.html
+        ${WORK_DIRECTORY}/videos/*.html
+        ${WORK_DIRECTORY}/channels/*.html
+)
+list(SORT expectedPages)
+list(SORT generatedPages)
+if (NOT expectedPages STREQUAL generatedPages)
+    message(FATAL_ERROR "Generated pages [${generatedPages}] instead of [${expectedPages}]")
+endif ()
+
+set(differentPages "")
+foreach (page IN LISTS expectedPages)
+    file(READ ${EXPECTED_DIRECTORY}/${page} expected)
+    file(READ ${WORK_DIRECTORY}/${page} generated)
+    string(REPLACE "${WORK_DIRECTORY}" "@ROOT@" generated "${generated}")
+    if (NOT generated STREQUAL expected)
+        list(APPEND differentPages ${page})
+    endif ()
+endforeach ()
+
+if (differentPages)
+    message(FATAL_ERROR "Pages differ from ${EXPECTED_DIRECTORY}: ${differentPages}")
+endif ()